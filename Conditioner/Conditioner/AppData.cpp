@@ -8,6 +8,10 @@ extern const QString loadSettingsWarningMessage{
 };
 
 extern const QString settingsPath{ "./settings.xml" };
+extern const qint64 SETTINGS_JOURNAL_LIMIT{ 64 * 1024 };
+extern const int SETTINGS_FUZZ_JOURNAL_INTERVAL{ 100 };
+extern const int SETTINGS_FUZZ_WINDOW_INTERVAL{ 1000 };
+extern const QString startupTracePath{ "./startup_trace.json" };
 
 extern const QString lightStyleSheetPath{ "./LightStyleSheet.css" };
 extern const QString darkStyleSheetPath{ "./DarkStyleSheet.css" };
@@ -42,8 +46,80 @@ extern const double KELVIN_MIN{ 263.15 };
 extern const double KELVIN_MAX{ 315.15 };
 extern const int HUMIDITY_MIN{ 0 };
 extern const int HUMIDITY_MAX{ 100 };
+extern const double MMHG_MIN{ 200.0 };
+extern const double MMHG_MAX{ 900.0 };
+extern const double PASCAL_MIN{ 26664.0 };
+extern const double PASCAL_MAX{ 119988.0 };
 
 extern const QString innerBlockErrorStyle{ "QLabel#innerBlock { background-color: #B85757; }" };
 extern const QString innerBlockOkStyle{ "QLabel#innerBlock { background-color: transparent; }" };
 extern const QString outerBlockErrorStyle{ "QLabel#outerBlock { background-color: #B85757; }" };
 extern const QString outerBlockOkStyle{ "QLabel#outerBlock { background-color: transparent; }" };
+
+extern const QString energyToolTipTemplate{
+	u8" : %1%\n"
+	": %2 \n"
+	": %3 *\n"
+	" : %4 *\n"
+	" : %5 *\n"
+	"  : %6 *"
+};
+
+extern const QString sensorLogStartText{ u8"  " };
+extern const QString sensorLogStopText{ u8" " };
+extern const QString sensorLogDialogTitle{ u8"  " };
+extern const QString sensorLogFileFilter{ u8" CSV (*.csv)" };
+extern const QString sensorLogOpenWarningMessage{ u8"     ." };
+
+extern const QString faultPanelText{ u8" " };
+extern const QString sendInnerIssueText{ u8" \n  " };
+extern const QString solveInnerIssueText{ u8"  \n " };
+extern const QString sendOuterIssueText{ u8" \n  " };
+extern const QString solveOuterIssueText{ u8" \n  " };
+
+extern const double COMPRESSOR_RATED_POWER{ 2.2 };
+extern const double FAN_POWER{ 0.06 };
+extern const double MIN_COMPRESSOR_LOAD{ 0.15 };
+extern const double FULL_LOAD_DELTA{ 8.0 };
+extern const double DEFLECTED_AIRFLOW_FACTOR{ 1.08 };
+extern const int ENERGY_UPDATE_INTERVAL{ 1000 };
+extern const int ENERGY_HISTORY_DAYS{ 56 };
+extern const double FORECAST_LEVEL_SMOOTHING{ 0.5 };
+extern const double FORECAST_TREND_SMOOTHING{ 0.3 };
+
+extern const int SENSOR_LOG_PLAYBACK_INTERVAL{ 100 };
+extern const double SENSOR_LOG_DECIMATION_INTERVAL{ 60.0 };
+
+extern const int UNDO_HISTORY_LIMIT{ 100 };
+
+extern const int FAULT_CHECK_INTERVAL{ 1000 };
+
+extern const int SIMULATION_CHUNK_SIZE{ 1024 };
+extern const double SIMULATION_THERMAL_TIME_CONSTANT{ 1800.0 };
+extern const double SIMULATION_CONDITIONING_RATE{ 0.01 };
+extern const double SIMULATION_DRYING_RATE{ 0.002 };
+extern const double SIMULATION_SENSOR_NOISE{ 0.02 };
+extern const double SIMULATION_PRESSURE_NOISE{ 5.0 };
+extern const double SIMULATION_FAULT_RATE{ 0.00001 };
+extern const double SIMULATION_REPAIR_RATE{ 0.001 };
+
+extern const int LOW_MEMORY_PIXMAP_CACHE_LIMIT{ 512 };
+extern const qint64 LOW_MEMORY_RSS_BUDGET{ 48 * 1024 * 1024 };
+
+extern const QString stateSegmentKey{ "Conditioner.ControllerState" };
+extern const quint32 STATE_SEGMENT_MAGIC{ 0x31444E43 };
+extern const int STATE_SEGMENT_READ_ATTEMPTS{ 64 };
+extern const int STATE_POLL_INTERVAL{ 1 };
+extern const int STATE_POLL_MAX_INTERVAL{ 500 };
+
+extern const QString telemetryPath{ "./telemetry" };
+extern const int TELEMETRY_BLOCK_SIZE{ 1024 };
+
+extern const int SCHEDULER_COALESCING_WINDOW{ 50 };
+extern const int SCHEDULER_STABLE_TICKS{ 5 };
+extern const int ENERGY_MAX_UPDATE_INTERVAL{ 16000 };
+extern const int FAULT_MAX_CHECK_INTERVAL{ 16000 };
+extern const double TEMPERATURE_HYSTERESIS{ 0.2 };
+extern const double HUMIDITY_HYSTERESIS{ 1.0 };
+extern const double PRESSURE_HYSTERESIS{ 50.0 };
+extern const double POWER_HYSTERESIS{ 0.02 };
@@ -11,6 +11,10 @@ extern const QString appIcon;
 extern const QString loadSettingsWarningMessage;
 
 extern const QString settingsPath;
+extern const qint64 SETTINGS_JOURNAL_LIMIT;
+extern const int SETTINGS_FUZZ_JOURNAL_INTERVAL;
+extern const int SETTINGS_FUZZ_WINDOW_INTERVAL;
+extern const QString startupTracePath;
 
 extern const QString lightStyleSheetPath;
 extern const QString darkStyleSheetPath;
@@ -45,8 +49,73 @@ extern const double KELVIN_MIN;
 extern const double KELVIN_MAX;
 extern const int HUMIDITY_MIN;
 extern const int HUMIDITY_MAX;
+extern const double MMHG_MIN;
+extern const double MMHG_MAX;
+extern const double PASCAL_MIN;
+extern const double PASCAL_MAX;
 
 extern const QString innerBlockErrorStyle;
 extern const QString innerBlockOkStyle;
 extern const QString outerBlockErrorStyle;
 extern const QString outerBlockOkStyle;
+
+extern const QString energyToolTipTemplate;
+
+extern const QString sensorLogStartText;
+extern const QString sensorLogStopText;
+extern const QString sensorLogDialogTitle;
+extern const QString sensorLogFileFilter;
+extern const QString sensorLogOpenWarningMessage;
+
+extern const QString faultPanelText;
+extern const QString sendInnerIssueText;
+extern const QString solveInnerIssueText;
+extern const QString sendOuterIssueText;
+extern const QString solveOuterIssueText;
+
+extern const double COMPRESSOR_RATED_POWER;
+extern const double FAN_POWER;
+extern const double MIN_COMPRESSOR_LOAD;
+extern const double FULL_LOAD_DELTA;
+extern const double DEFLECTED_AIRFLOW_FACTOR;
+extern const int ENERGY_UPDATE_INTERVAL;
+extern const int ENERGY_HISTORY_DAYS;
+extern const double FORECAST_LEVEL_SMOOTHING;
+extern const double FORECAST_TREND_SMOOTHING;
+
+extern const int SENSOR_LOG_PLAYBACK_INTERVAL;
+extern const double SENSOR_LOG_DECIMATION_INTERVAL;
+
+extern const int UNDO_HISTORY_LIMIT;
+
+extern const int FAULT_CHECK_INTERVAL;
+
+extern const int SIMULATION_CHUNK_SIZE;
+extern const double SIMULATION_THERMAL_TIME_CONSTANT;
+extern const double SIMULATION_CONDITIONING_RATE;
+extern const double SIMULATION_DRYING_RATE;
+extern const double SIMULATION_SENSOR_NOISE;
+extern const double SIMULATION_PRESSURE_NOISE;
+extern const double SIMULATION_FAULT_RATE;
+extern const double SIMULATION_REPAIR_RATE;
+
+extern const int LOW_MEMORY_PIXMAP_CACHE_LIMIT;
+extern const qint64 LOW_MEMORY_RSS_BUDGET;
+
+extern const QString stateSegmentKey;
+extern const quint32 STATE_SEGMENT_MAGIC;
+extern const int STATE_SEGMENT_READ_ATTEMPTS;
+extern const int STATE_POLL_INTERVAL;
+extern const int STATE_POLL_MAX_INTERVAL;
+
+extern const QString telemetryPath;
+extern const int TELEMETRY_BLOCK_SIZE;
+
+extern const int SCHEDULER_COALESCING_WINDOW;
+extern const int SCHEDULER_STABLE_TICKS;
+extern const int ENERGY_MAX_UPDATE_INTERVAL;
+extern const int FAULT_MAX_CHECK_INTERVAL;
+extern const double TEMPERATURE_HYSTERESIS;
+extern const double HUMIDITY_HYSTERESIS;
+extern const double PRESSURE_HYSTERESIS;
+extern const double POWER_HYSTERESIS;
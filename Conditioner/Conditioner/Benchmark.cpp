@@ -0,0 +1,1012 @@
+#include "Benchmark.h"
+#include "AppData.h"
+#include "EnergyModel.h"
+#include "EnergyAnalytics.h"
+#include "SensorLogReader.h"
+#include "StateHistory.h"
+#include "FaultRuleEngine.h"
+#include "UnitSimulation.h"
+#include "StateSegment.h"
+#include "TelemetryStore.h"
+#include "UpdateScheduler.h"
+#include "SettingsStore.h"
+#include "SettingsFuzzer.h"
+#include "CustomMainWindow.h"
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QDir>
+#include <QFile>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+#include <QPixmapCache>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#if defined(Q_OS_WIN)
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+    @brief  ,      
+	      .
+    @param  out -    .
+    @retval     -   .
+**/
+int benchmarkEnergy(QTextStream& out) {
+	const int units = 10000;
+	const int days = ENERGY_HISTORY_DAYS;
+	const int iterations = 20;
+	EnergyModel model(units);
+	EnergyAnalytics analytics(units, days);
+	QVector<float> consumed(units);
+	for (int i = 0; i < units; i++) {
+		model.setPower(i, true);
+		model.setSetpoint(i, 22.0);
+		model.setDirection(i, AirDirection(i % 3));
+	}
+	QElapsedTimer timer;
+	timer.start();
+	for (qint64 hour = 0; hour < qint64(days) * 24; hour++) {
+		for (int i = 0; i < units; i++) {
+			model.setRoomTemperature(i, 22.0 + (hour % 24) * 0.5 + (i % 7));
+		}
+		model.step(3600.0, consumed.data());
+		analytics.accumulate(hour * 3600, consumed.constData());
+	}
+	qint64 fillTime = timer.elapsed();
+
+	QVector<float> totals;
+	double checksum = 0.0;
+	timer.restart();
+	for (int n = 0; n < iterations; n++) {
+		analytics.computeDailyTotals(analytics.getLastDay(), totals);
+		checksum += EnergyAnalytics::sumTotals(totals);
+	}
+	double dailyTime = timer.nsecsElapsed() / 1e6 / iterations;
+	timer.restart();
+	for (int n = 0; n < iterations; n++) {
+		analytics.computeWeeklyTotals(analytics.getLastDay(), totals);
+		checksum += EnergyAnalytics::sumTotals(totals);
+	}
+	double weeklyTime = timer.nsecsElapsed() / 1e6 / iterations;
+	timer.restart();
+	for (int n = 0; n < iterations; n++) {
+		analytics.computeDailyForecast(totals, 7);
+		checksum += EnergyAnalytics::sumTotals(totals);
+	}
+	double forecastTime = timer.nsecsElapsed() / 1e6 / iterations;
+
+	out << "energy: units=" << units << " days=" << days << " fill=" << fillTime << " ms\n";
+	out << "energy: daily totals " << dailyTime << " ms\n";
+	out << "energy: weekly totals " << weeklyTime << " ms\n";
+	out << "energy: weekly forecast " << forecastTime << " ms\n";
+	out << "energy: checksum " << checksum << "\n";
+	return 0;
+}
+
+/**
+    @brief  ,      .
+	        
+	:         .
+    @param  out       -    .
+    @param  arguments -     ,   256.
+    @retval           -   .
+**/
+int benchmarkSensorLog(QTextStream& out, const QStringList& arguments) {
+	qint64 targetSize = (arguments.isEmpty() ? 256 : arguments.at(0).toLongLong()) * 1024 * 1024;
+	QString path = QDir::tempPath() + "/conditioner_benchmark.csv";
+	QFile file(path);
+	if (!file.open(QFile::WriteOnly)) {
+		out << "csv: cannot create " << path << "\n";
+		return 1;
+	}
+	file.write("timestamp,temperature,humidity,pressure\n");
+	QByteArray chunk;
+	qint64 written = 0;
+	for (qint64 row = 0; written < targetSize; row++) {
+		chunk += QByteArray::number(1700000000 + row);
+		chunk += ',';
+		chunk += QByteArray::number(18.0 + (row % 1000) * 0.01, 'f', 2);
+		chunk += ',';
+		chunk += QByteArray::number(30 + int(row % 40));
+		chunk += ',';
+		chunk += QByteArray::number(101325.0 + (row % 500) * 0.5, 'f', 1);
+		chunk += '\n';
+		if (chunk.size() >= 1 << 20) {
+			written += file.write(chunk);
+			chunk.clear();
+		}
+	}
+	written += file.write(chunk);
+	file.close();
+
+	const double intervals[] = { 0.0, 60.0 };
+	QVector<SensorSample> samples(4096);
+	for (double interval : intervals) {
+		SensorLogReader reader(path);
+		if (!reader.open()) {
+			out << "csv: cannot open " << path << "\n";
+			QFile::remove(path);
+			return 1;
+		}
+		QElapsedTimer timer;
+		timer.start();
+		qint64 produced = 0;
+		double checksum = 0.0;
+		int count = 0;
+		while ((count = reader.read(samples.data(), samples.size(), interval)) > 0) {
+			produced += count;
+			checksum += samples[count - 1].temperature;
+		}
+		double seconds = timer.nsecsElapsed() / 1e9;
+		out << "csv: interval=" << interval << " s size=" << reader.getSize() / 1048576.0 << " MB rows="
+			<< reader.getRowCount() << " samples=" << produced << " errors=" << reader.getErrorCount() << "\n";
+		out << "csv: " << reader.getSize() / 1048576.0 / seconds << " MB/s " << reader.getRowCount() / seconds
+			<< " rows/s checksum " << checksum << "\n";
+	}
+	QFile::remove(path);
+	return 0;
+}
+
+/**
+    @brief  ,       
+	     .   
+	   .
+    @param  out       -    .
+    @param  arguments -   ,   100000.
+    @retval           -   .
+**/
+int benchmarkUndo(QTextStream& out, const QStringList& arguments) {
+	const int zones = arguments.isEmpty() ? 100000 : arguments.at(0).toInt();
+	const int changes = 10000;
+	const int copies = 100;
+	ZoneState zone{ "22", "celsiusButton", "mmHgButton", "centerDirButton" };
+	ControllerState state;
+	QVector<ZoneState> plainZones;
+	for (int i = 0; i < zones; i++) {
+		state.zones = state.zones.append(zone);
+		plainZones.append(zone);
+	}
+	StateHistory history(changes + 1);
+	history.reset(state);
+
+	QElapsedTimer timer;
+	timer.start();
+	for (int n = 0; n < changes; n++) {
+		int changedZone = int((qint64(n) * 7919) % zones);
+		ControllerState next = history.current();
+		ZoneState changed = next.zones.at(changedZone);
+		changed.temperature = QString::number(n % 30);
+		next.zones = next.zones.set(changedZone, changed);
+		history.push(next);
+	}
+	double snapshotTime = timer.nsecsElapsed() / 1e3 / changes;
+
+	qint64 checksum = 0;
+	timer.restart();
+	while (history.canUndo()) {
+		checksum += history.undo().zones.at(0).temperature.size();
+	}
+	while (history.canRedo()) {
+		checksum += history.redo().zones.at(0).temperature.size();
+	}
+	double restoreTime = timer.nsecsElapsed() / 1e3 / (2.0 * changes);
+
+	QVector<QVector<ZoneState>> plainSnapshots;
+	timer.restart();
+	for (int n = 0; n < copies; n++) {
+		QVector<ZoneState> copy = plainZones;
+		copy[n % zones].temperature = QString::number(n % 30);
+		plainSnapshots.append(copy);
+	}
+	double copyTime = timer.nsecsElapsed() / 1e3 / copies;
+
+	int depth = 1;
+	for (qint64 capacity = 32; capacity < zones; capacity *= 32) {
+		depth++;
+	}
+	qint64 pathBytes = qint64(depth - 1) * (32 * qint64(sizeof(void*) * 2)) + 32 * qint64(sizeof(ZoneState));
+	out << "undo: zones=" << zones << " snapshots=" << changes << " depth=" << depth << "\n";
+	out << "undo: change + snapshot " << snapshotTime << " us, ~" << pathBytes << " bytes copied\n";
+	out << "undo: restore " << restoreTime << " us\n";
+	out << "undo: full copy baseline " << copyTime << " us, " << qint64(zones) * qint64(sizeof(ZoneState)) << " bytes\n";
+	out << "undo: checksum " << checksum << "\n";
+	return 0;
+}
+
+/**
+    @brief  ,     
+	    .
+    @param  out       -    .
+    @param  arguments -      
+	 ,   5000  200.
+    @retval           -   .
+**/
+int benchmarkRules(QTextStream& out, const QStringList& arguments) {
+	const int units = arguments.size() > 0 ? arguments.at(0).toInt() : 5000;
+	const int ruleCount = arguments.size() > 1 ? arguments.at(1).toInt() : 200;
+	const int ticks = 50;
+	QVector<FaultRule> defaults = FaultRuleEngine::getDefaultRules();
+	QVector<FaultRule> rules;
+	for (int r = 0; r < ruleCount; r++) {
+		FaultRule rule = defaults.at(r % defaults.size());
+		rule.limit *= 1.0f + 0.001f * (r / defaults.size());
+		rules.append(rule);
+	}
+	FaultRuleEngine engine(units);
+	engine.setRules(rules);
+	QVector<float> temperature(units);
+	QVector<float> humidity(units);
+	QVector<float> pressure(units);
+	QVector<quint8> faults(units);
+	qint64 faultCount = 0;
+	QElapsedTimer timer;
+	qint64 elapsed = 0;
+	for (int tick = 0; tick < ticks; tick++) {
+		for (int u = 0; u < units; u++) {
+			temperature[u] = 20.0f + float((u * 13 + tick * 7) % 300) / 10.0f;
+			humidity[u] = float((u * 7 + tick) % 100);
+			pressure[u] = 100000.0f + float((u * 31 + tick * 101) % 20000) - 10000.0f;
+		}
+		timer.start();
+		engine.evaluate(temperature.constData(), humidity.constData(), pressure.constData(), 1.0f, faults.data());
+		elapsed += timer.nsecsElapsed();
+		for (int u = 0; u < units; u++) {
+			faultCount += faults[u] != 0;
+		}
+	}
+	double tickTime = elapsed / 1e6 / ticks;
+	out << "rules: units=" << units << " rules/unit=" << ruleCount << " ticks=" << ticks << "\n";
+	out << "rules: " << tickTime << " ms/tick, " << double(units) * ruleCount * ticks / (elapsed / 1e9) << " rule evaluations/s\n";
+	out << "rules: faulty unit-ticks " << faultCount << "\n";
+	return 0;
+}
+
+/**
+    @brief  ,     
+	    1     ,  
+	     .
+    @param  out       -    .
+    @param  arguments -      ,
+	  100000  100.
+    @retval           -   : 1,  
+	     .
+**/
+int benchmarkScaling(QTextStream& out, const QStringList& arguments) {
+	const int units = arguments.size() > 0 ? arguments.at(0).toInt() : 100000;
+	const int steps = arguments.size() > 1 ? arguments.at(1).toInt() : 100;
+	const int maxThreads = qMax(int(std::thread::hardware_concurrency()), 1);
+	const quint64 seed = 20240601;
+	out << "scaling: units=" << units << " steps=" << steps << " cores=" << maxThreads << "\n";
+	quint64 referenceChecksum = 0;
+	double referenceTime = 0.0;
+	bool deterministic = true;
+	for (int threads = 1; threads <= maxThreads; threads++) {
+		UnitSimulation simulation(units, seed);
+		WorkStealingPool pool(threads);
+		QElapsedTimer timer;
+		timer.start();
+		for (int step = 0; step < steps; step++) {
+			simulation.step(pool, 1.0);
+		}
+		double seconds = timer.nsecsElapsed() / 1e9;
+		quint64 checksum = simulation.computeChecksum();
+		if (threads == 1) {
+			referenceChecksum = checksum;
+			referenceTime = seconds;
+		}
+		bool matches = checksum == referenceChecksum;
+		deterministic = deterministic && matches;
+		out << "scaling: threads=" << threads << " " << double(units) * steps / seconds << " unit-steps/s, speedup "
+			<< referenceTime / seconds << ", steals " << pool.getStealCount() << ", checksum "
+			<< QString::number(checksum, 16) << (matches ? "" : " MISMATCH") << "\n";
+	}
+	return deterministic ? 0 : 1;
+}
+
+/**
+    @brief ,     .
+    @param out       -    .
+    @param label     -   .
+    @param latencies -   ; .
+**/
+void reportLatencies(QTextStream& out, const QString& label, QVector<qint64>& latencies) {
+	std::sort(latencies.begin(), latencies.end());
+	out << "segment: " << label << " observed " << latencies.size();
+	if (!latencies.isEmpty()) {
+		out << ", latency median " << latencies[latencies.size() / 2] / 1000.0 << " us, p99 "
+			<< latencies[int(latencies.size() * 0.99)] / 1000.0 << " us, max " << latencies.last() / 1000.0 << " us";
+	}
+	out << "\n";
+}
+
+/**
+    @brief  ,      
+	 .       
+	,        
+	  .     ,   
+	:      STATE_POLL_INTERVAL,
+	         .
+	 ,       .
+    @param  out       -    .
+    @param  arguments -   ,  
+	100000;      100  .
+    @retval           -   : 1,    ,
+	       .
+**/
+int benchmarkStateSegment(QTextStream& out, const QStringList& arguments) {
+	const int updates = arguments.size() > 0 ? arguments.at(0).toInt() : 100000;
+	const qint64 pause = 2000;
+	const int pollUpdates = qMax(updates / 100, 1);
+	const int pollPause = 3700;
+	QString key = stateSegmentKey + ".benchmark." + QString::number(QCoreApplication::applicationPid());
+	StateSegment writer(key);
+	StateSegment reader(key);
+	if (!writer.create() || !reader.attach()) {
+		out << "segment: cannot map shared memory\n";
+		return 1;
+	}
+	StateSegment secondWriter(key);
+	bool exclusive = !secondWriter.create();
+	out << "segment: second writer " << (exclusive ? "rejected" : "ACCEPTED") << "\n";
+
+	std::atomic<bool> finished(false);
+	QVector<qint64> latencies;
+	qint64 torn = 0;
+	std::thread readerThread([&] {
+		SharedPanelState state;
+		quint32 sequence = 0;
+		while (!finished.load(std::memory_order_relaxed)) {
+			if (reader.read(state, sequence)) {
+				latencies.append(StateSegment::getClock() - state.publishedAt);
+				torn += StateSegment::getText(state.temperature).toDouble() != state.consumedEnergy;
+			}
+		}
+	});
+	SharedPanelState state = {};
+	QElapsedTimer timer;
+	timer.start();
+	for (int i = 0; i < updates; i++) {
+		StateSegment::setText(state.temperature, QString::number(i));
+		state.consumedEnergy = i;
+		writer.publish(state);
+		qint64 until = StateSegment::getClock() + pause;
+		while (StateSegment::getClock() < until) {
+		}
+	}
+	double seconds = timer.nsecsElapsed() / 1e9;
+	finished.store(true);
+	readerThread.join();
+	out << "segment: updates=" << updates << " published " << updates / seconds << " updates/s\n";
+	reportLatencies(out, "spinning reader", latencies);
+
+	QVector<qint64> pollLatencies;
+	quint32 pollSequence = reader.getSequence();
+	finished.store(false);
+	std::thread writerThread([&] {
+		SharedPanelState update = {};
+		for (int i = 0; i < pollUpdates; i++) {
+			StateSegment::setText(update.temperature, QString::number(i));
+			update.consumedEnergy = i;
+			writer.publish(update);
+			std::this_thread::sleep_for(std::chrono::microseconds(pollPause));
+		}
+		finished.store(true);
+	});
+	QEventLoop loop;
+	UpdateScheduler scheduler;
+	scheduler.addTask(STATE_POLL_INTERVAL, STATE_POLL_MAX_INTERVAL, [&] {
+		SharedPanelState snapshot;
+		bool changed = reader.read(snapshot, pollSequence);
+		if (changed) {
+			pollLatencies.append(StateSegment::getClock() - snapshot.publishedAt);
+			torn += StateSegment::getText(snapshot.temperature).toDouble() != snapshot.consumedEnergy;
+		}
+		if (finished.load()) {
+			loop.quit();
+		}
+		return changed;
+	});
+	scheduler.start();
+	loop.exec();
+	scheduler.stop();
+	writerThread.join();
+	reportLatencies(out, QString("scheduler poll from %1 ms").arg(STATE_POLL_INTERVAL), pollLatencies);
+	out << "segment: inconsistent snapshots " << torn << "\n";
+	return exclusive && torn == 0 ? 0 : 1;
+}
+
+/**
+    @brief  ,        1 
+	   :     . 
+	     .
+    @param  out       -    .
+    @param  arguments -      ,
+	  100  24.
+    @retval           -   .
+**/
+int benchmarkTelemetry(QTextStream& out, const QStringList& arguments) {
+	const int units = arguments.size() > 0 ? arguments.at(0).toInt() : 100;
+	const int hours = arguments.size() > 1 ? arguments.at(1).toInt() : 24;
+	const double start = 1700000000.0;
+	QString path = QDir::tempPath() + "/conditioner_benchmark_telemetry";
+	QFile::remove(path + ".dat");
+	QFile::remove(path + ".idx");
+	qint64 encodeTime = 0;
+	{
+		TelemetryStore store(path);
+		if (!store.open()) {
+			out << "telemetry: cannot create " << path << "\n";
+			return 1;
+		}
+		UnitSimulation simulation(units, 20240601);
+		WorkStealingPool pool(1);
+		QElapsedTimer timer;
+		for (int second = 0; second < hours * 3600; second++) {
+			simulation.step(pool, 1.0);
+			timer.start();
+			for (int u = 0; u < units; u++) {
+				SensorSample sample;
+				sample.timestamp = start + second;
+				sample.temperature = qRound(simulation.getTemperature(u) * 10.0) / 10.0;
+				sample.humidity = qRound(simulation.getHumidity(u));
+				sample.pressure = qRound(simulation.getPressure(u));
+				store.append(u, sample);
+			}
+			encodeTime += timer.nsecsElapsed();
+		}
+		out << "telemetry: units=" << units << " hours=" << hours << " points=" << store.getPointCount() << "\n";
+		out << "telemetry: " << store.getStoredBytes() << " bytes, " << double(store.getStoredBytes()) / store.getPointCount()
+			<< " bytes/point (raw " << sizeof(SensorSample) << "), encode " << store.getPointCount() / (encodeTime / 1e9) << " points/s\n";
+	}
+	TelemetryStore store(path);
+	store.open();
+	QVector<SensorSample> samples;
+	QElapsedTimer timer;
+	timer.start();
+	qint64 decoded = 0;
+	for (int u = 0; u < units; u++) {
+		samples.clear();
+		decoded += store.query(u, start, start + hours * 3600.0, samples);
+	}
+	double seconds = timer.nsecsElapsed() / 1e9;
+	out << "telemetry: full decode " << decoded / seconds << " points/s, " << store.getDecodedBlockCount() << " blocks\n";
+	qint64 blocksBefore = store.getDecodedBlockCount();
+	timer.start();
+	int found = 0;
+	for (int u = 0; u < units; u++) {
+		samples.clear();
+		found += store.query(u, start + hours * 1800.0, start + hours * 1800.0 + 3600.0, samples);
+	}
+	out << "telemetry: 1 h range query " << timer.nsecsElapsed() / 1e3 / units << " us/unit, " << found / units << " points/unit, "
+		<< double(store.getDecodedBlockCount() - blocksBefore) / units << " blocks/unit\n";
+	store.close();
+	QFile::remove(path + ".dat");
+	QFile::remove(path + ".idx");
+	return 0;
+}
+
+/**
+    @brief  ,       
+	 ,     .
+    @param  milliseconds -   .
+    @retval              -    .
+**/
+qint64 runEventLoop(int milliseconds) {
+	QEventLoop loop;
+	QTimer::singleShot(milliseconds, &loop, &QEventLoop::quit);
+	qint64 cpuTime = UpdateScheduler::getProcessCpuTime();
+	loop.exec();
+	return UpdateScheduler::getProcessCpuTime() - cpuTime;
+}
+
+/**
+    @brief  ,      
+	        
+	,     . 
+	  ,    .
+    @param  out       -    .
+    @param  arguments -      
+	     ,   10  100.
+    @retval           -   : 1,  
+	       .
+**/
+int benchmarkIdle(QTextStream& out, const QStringList& arguments) {
+	const int seconds = arguments.size() > 0 ? arguments.at(0).toInt() : 10;
+	const int interval = arguments.size() > 1 ? arguments.at(1).toInt() : 100;
+	qint64 ticks = 0;
+	ChangeDetector temperatureChange(TEMPERATURE_HYSTERESIS);
+	ChangeDetector humidityChange(HUMIDITY_HYSTERESIS);
+	auto checkSensors = [&] {
+		ticks++;
+		bool changed = temperatureChange.update(22.0 + 0.05 * (ticks % 3 - 1));
+		return humidityChange.update(45.0 + 0.5 * (ticks % 2)) || changed;
+	};
+	out << "idle: " << seconds << " s per mode, base interval " << interval << " ms\n";
+
+	qint64 fixedWakeups = 0;
+	QTimer energyTimer;
+	QTimer faultTimer;
+	energyTimer.setInterval(interval);
+	faultTimer.setInterval(interval);
+	QObject::connect(&energyTimer, &QTimer::timeout, [&] { fixedWakeups++; checkSensors(); });
+	QObject::connect(&faultTimer, &QTimer::timeout, [&] { fixedWakeups++; checkSensors(); });
+	energyTimer.start();
+	QTimer::singleShot(interval / 2, &faultTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+	qint64 cpuTime = runEventLoop(seconds * 1000);
+	energyTimer.stop();
+	faultTimer.stop();
+	double fixedRate = double(fixedWakeups) / seconds;
+	out << "idle: fixed timers " << fixedRate << " wakeups/s, CPU " << cpuTime / 1e6 / seconds << " ms/s\n";
+
+	UpdateScheduler scheduler;
+	int energyTask = scheduler.addTask(interval, interval * 16, checkSensors);
+	scheduler.addTask(interval, interval * 16, checkSensors);
+	scheduler.start();
+	cpuTime = runEventLoop(seconds * 1000);
+	double adaptiveRate = double(scheduler.getWakeupCount()) / seconds;
+	out << "idle: adaptive scheduler " << adaptiveRate << " wakeups/s, CPU " << cpuTime / 1e6 / seconds
+		<< " ms/s, interval " << scheduler.getInterval(energyTask) << " ms\n";
+	out << "idle: scheduler active " << scheduler.formatStatistics() << "\n";
+
+	scheduler.stop();
+	qint64 wakeups = scheduler.getWakeupCount();
+	cpuTime = runEventLoop(seconds * 1000);
+	out << "idle: power off " << double(scheduler.getWakeupCount() - wakeups) / seconds << " wakeups/s, CPU "
+		<< cpuTime / 1e6 / seconds << " ms/s\n";
+	out << "idle: scheduler idle " << scheduler.formatStatistics() << "\n";
+	return adaptiveRate < fixedRate ? 0 : 1;
+}
+
+/**
+    @brief  ,     
+	      :   
+	    .  
+	     .
+    @param  out       -    .
+    @param  arguments -     
+	,   10000  1000.
+    @retval           -   : 1,  
+	   .
+**/
+int benchmarkSettings(QTextStream& out, const QStringList& arguments) {
+	const int zones = arguments.size() > 0 ? arguments.at(0).toInt() : 10000;
+	const int saves = arguments.size() > 1 ? arguments.at(1).toInt() : 1000;
+	QString path = QDir::tempPath() + "/conditioner_benchmark_settings.xml";
+	QFile::remove(path);
+	QFile::remove(path + ".journal");
+	QFile::remove(path + ".compacting");
+	SettingsStore store(path);
+	store.setValue("theme", "lightToggle");
+	store.setValue("energyMeter", "0.000000");
+	for (int zone = 0; zone < zones; zone++) {
+		store.setValue(SettingsStore::zoneKey(zone, "temperature"), "22");
+		store.setValue(SettingsStore::zoneKey(zone, "temperatureMode"), "celsiusButton");
+		store.setValue(SettingsStore::zoneKey(zone, "humidity"), "45%");
+		store.setValue(SettingsStore::zoneKey(zone, "pressure"), "760");
+		store.setValue(SettingsStore::zoneKey(zone, "pressureMode"), "mmHgButton");
+		store.setValue(SettingsStore::zoneKey(zone, "direction"), "centerDirButton");
+	}
+	store.commit();
+	QElapsedTimer timer;
+	timer.start();
+	QByteArray snapshot = SettingsStore::formatSnapshot(store.getValues(), store.getSequence());
+	QFile file(path + ".full");
+	file.open(QFile::WriteOnly);
+	file.write(snapshot);
+	file.close();
+	double fullTime = timer.nsecsElapsed() / 1e3;
+	QFile::remove(path + ".full");
+	out << "settings: zones=" << zones << " keys=" << store.getValues().size() << "\n";
+	out << "settings: full rewrite " << fullTime << " us, " << snapshot.size() << " bytes per save\n";
+	store.compact();
+	store.waitForCompaction();
+	qint64 writtenBefore = store.getWrittenBytes();
+	int compactionsBefore = store.getCompactionCount();
+	quint64 random = 20240601;
+	timer.start();
+	for (int i = 0; i < saves; i++) {
+		random = random * 6364136223846793005ull + 1442695040888963407ull;
+		int zone = int((random >> 33) % quint64(zones));
+		store.setValue(SettingsStore::zoneKey(zone, "temperature"), QString::number(16 + i % 15));
+		store.setValue("energyMeter", QString::number(i * 0.001, 'f', 6));
+		store.commit();
+	}
+	double journalTime = timer.nsecsElapsed() / 1e3 / saves;
+	store.waitForCompaction();
+	out << "settings: journal " << journalTime << " us, " << double(store.getWrittenBytes() - writtenBefore) / saves
+		<< " bytes per save, " << store.getCompactionCount() - compactionsBefore << " background compactions\n";
+	SettingsStore loaded(path);
+	timer.start();
+	bool valid = loaded.load();
+	out << "settings: load " << timer.nsecsElapsed() / 1e6 << " ms, journal " << loaded.getJournalBytes() << " bytes\n";
+	bool matches = valid && loaded.getValues() == store.getValues();
+	out << "settings: reloaded values " << (matches ? "match" : "MISMATCH") << "\n";
+	QFile::remove(path);
+	QFile::remove(path + ".journal");
+	QFile::remove(path + ".compacting");
+	return matches ? 0 : 1;
+}
+
+/**
+    @brief ,   fuzz   ,   
+	  ,    ,  
+	.      -
+	 ,    .
+**/
+const QByteArray* volatile fuzzInput = nullptr;
+volatile int fuzzIteration = 0;
+QByteArray fuzzCrashPath;
+#if defined(Q_OS_WIN)
+#define FUZZ_OPEN(path) _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE)
+#define FUZZ_WRITE(file, data, size) _write(file, data, unsigned(size))
+#define FUZZ_CLOSE(file) _close(file)
+#else
+#define FUZZ_OPEN(path) open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)
+#define FUZZ_WRITE(file, data, size) write(file, data, size_t(size))
+#define FUZZ_CLOSE(file) close(file)
+#endif
+
+/**
+    @brief  ,       
+	   ,    .
+    @param  out       -    .
+    @param  arguments -     
+	 ,   10000  10.
+    @retval           -   : 1,   
+	       .
+**/
+int benchmarkSettingsParse(QTextStream& out, const QStringList& arguments) {
+	const int zones = arguments.size() > 0 ? arguments.at(0).toInt() : 10000;
+	const int repeats = qMax(arguments.size() > 1 ? arguments.at(1).toInt() : 10, 1);
+	QHash<QString, QString> expected = SettingsFuzzer::generateValues(zones);
+	QByteArray snapshot = SettingsStore::formatSnapshot(expected, quint64(zones));
+	QByteArray journal = SettingsFuzzer::generateJournal(zones, zones);
+	QHash<QString, QString> values;
+	quint64 sequence = 0;
+	bool valid = true;
+	QElapsedTimer timer;
+	timer.start();
+	for (int i = 0; i < repeats; i++) {
+		values.clear();
+		valid = SettingsStore::parseSnapshot(snapshot, values, sequence) && valid;
+	}
+	double snapshotTime = timer.nsecsElapsed() / 1e9;
+	bool matches = valid && values == expected && sequence == quint64(zones);
+	timer.start();
+	for (int i = 0; i < repeats; i++) {
+		valid = SettingsStore::parseJournal(journal, 0, values, sequence) && valid;
+	}
+	double journalTime = timer.nsecsElapsed() / 1e9;
+	matches = matches && valid && values.size() == expected.size() && sequence == quint64(zones);
+	out << "parse: zones=" << zones << " keys=" << expected.size() << " repeats=" << repeats << "\n";
+	out << "parse: snapshot " << snapshot.size() << " bytes, " << snapshotTime * 1e3 / repeats << " ms, "
+		<< snapshot.size() * double(repeats) / snapshotTime / (1024 * 1024) << " MB/s\n";
+	out << "parse: journal " << journal.size() << " bytes, " << journalTime * 1e3 / repeats << " ms, "
+		<< journal.size() * double(repeats) / journalTime / (1024 * 1024) << " MB/s\n";
+	out << "parse: values " << (matches ? "match" : "MISMATCH") << "\n";
+	return matches ? 0 : 1;
+}
+
+/**
+    @brief ,        .
+    @param text - .
+**/
+void writeFuzzText(const char* text) {
+	FUZZ_WRITE(2, text, std::strlen(text));
+}
+
+/**
+    @brief ,       
+	    .
+    @param value - .
+**/
+void writeFuzzNumber(int value) {
+	char digits[16];
+	int position = sizeof(digits);
+	do {
+		digits[--position] = char('0' + value % 10);
+		value /= 10;
+	} while (value > 0 && position > 0);
+	FUZZ_WRITE(2, digits + position, sizeof(digits) - position);
+}
+
+/**
+    @brief -      
+	fuzz:    ,      
+	   2.      ,
+	   ,    
+	,    .
+    @param signal -  .
+**/
+void reportFuzzCrash(int signal) {
+	writeFuzzText("fuzz: CRASH signal ");
+	writeFuzzNumber(signal);
+	writeFuzzText(" at input ");
+	writeFuzzNumber(fuzzIteration);
+	const QByteArray* input = fuzzInput;
+	int file = input != nullptr ? FUZZ_OPEN(fuzzCrashPath.constData()) : -1;
+	if (file >= 0) {
+		FUZZ_WRITE(file, input->constData(), input->size());
+		FUZZ_CLOSE(file);
+		writeFuzzText(", saved to ");
+		writeFuzzText(fuzzCrashPath.constData());
+	}
+	writeFuzzText("\n");
+	std::_Exit(2);
+}
+
+/**
+    @brief  ,       
+	,  ,   :  ,   ,
+	    .
+    @param  data -   .
+    @param  path -    ;     
+	.
+    @retval      -  true,      ,  false.
+**/
+bool loadSettingsWindow(const QByteArray& data, const QString& path) {
+	QFile::remove(path + ".journal");
+	QFile::remove(path + ".compacting");
+	QFile file(path);
+	if (!file.open(QFile::WriteOnly) || file.write(data) != data.size()) {
+		return false;
+	}
+	file.close();
+	CustomMainWindow window(nullptr, false, false, path);
+	return true;
+}
+
+/**
+    @brief  ,      
+	      . 
+	SETTINGS_FUZZ_JOURNAL_INTERVAL ,  , 
+	  ,      , 
+	 SETTINGS_FUZZ_WINDOW_INTERVAL    
+	,   .  ,   ,
+	  ; ,   , 
+	  ,   .
+    @param  out       -    .
+    @param  arguments -     
+	 ,   100000  1.
+    @retval           -   : 1,  -  
+	 ,  0;     
+	  2   .
+**/
+int benchmarkSettingsFuzz(QTextStream& out, const QStringList& arguments) {
+	const int iterations = arguments.size() > 0 ? arguments.at(0).toInt() : 100000;
+	const quint64 seed = arguments.size() > 1 ? arguments.at(1).toULongLong() : 1;
+	QHash<QString, QString> special;
+	special.insert("theme", "a<b>&\"c\"\td\r\ne\\");
+	special.insert(SettingsStore::zoneKey(0, "temperature"), QString());
+	QList<QByteArray> corpus;
+	corpus.append(SettingsStore::formatSnapshot(SettingsFuzzer::generateValues(2), 3));
+	corpus.append(SettingsStore::formatSnapshot(special, 18446744073709551615ull));
+	corpus.append(SettingsFuzzer::generateLegacySnapshot());
+	corpus.append(SettingsFuzzer::generateJournal(2, 3));
+	corpus.append("1\tweird\\tkey\tline\\nbreak\\\\x\n2\ttheme\t\n");
+	QString failurePath = QDir::tempPath() + "/conditioner_fuzz_failure.bin";
+	QString settingsFile = QDir::tempPath() + "/conditioner_fuzz_settings.xml";
+	fuzzCrashPath = QDir::toNativeSeparators(QDir::tempPath() + "/conditioner_fuzz_crash.bin").toLocal8Bit();
+	std::signal(SIGSEGV, reportFuzzCrash);
+	std::signal(SIGABRT, reportFuzzCrash);
+	std::signal(SIGFPE, reportFuzzCrash);
+	std::signal(SIGILL, reportFuzzCrash);
+	SettingsFuzzer fuzzer(seed);
+	int failures = 0;
+	int journalChecks = 0;
+	int windowLoads = 0;
+	qint64 bytes = 0;
+	QElapsedTimer timer;
+	timer.start();
+	for (int i = 0; i < iterations; i++) {
+		QByteArray input = fuzzer.mutate(corpus.at(i % corpus.size()));
+		QByteArray journal;
+		fuzzInput = &input;
+		fuzzIteration = i;
+		bool passed = SettingsFuzzer::checkInput(input);
+		if (passed && i % SETTINGS_FUZZ_JOURNAL_INTERVAL == 0) {
+			int round = i / SETTINGS_FUZZ_JOURNAL_INTERVAL;
+			journal = round % 2 == 0 ? fuzzer.tear(corpus.at(3 + round / 2 % 2)) : input;
+			fuzzInput = &journal;
+			passed = SettingsFuzzer::checkJournalAppend(journal, settingsFile);
+			journalChecks++;
+		}
+		if (passed && i % SETTINGS_FUZZ_WINDOW_INTERVAL == 0) {
+			fuzzInput = &input;
+			passed = loadSettingsWindow(input, settingsFile);
+			windowLoads++;
+		}
+		if (!passed) {
+			if (failures == 0) {
+				QFile file(failurePath);
+				file.open(QFile::WriteOnly);
+				file.write(*fuzzInput);
+				out << "fuzz: input " << i << " failed the check, saved to " << failurePath << "\n";
+				out.flush();
+			}
+			failures++;
+		}
+		bytes += input.size();
+	}
+	double seconds = timer.nsecsElapsed() / 1e9;
+	fuzzInput = nullptr;
+	std::signal(SIGSEGV, SIG_DFL);
+	std::signal(SIGABRT, SIG_DFL);
+	std::signal(SIGFPE, SIG_DFL);
+	std::signal(SIGILL, SIG_DFL);
+	QFile::remove(settingsFile);
+	QFile::remove(settingsFile + ".journal");
+	QFile::remove(settingsFile + ".compacting");
+	out << "fuzz: seed=" << seed << " inputs=" << iterations << " " << iterations / seconds << " inputs/s, "
+		<< bytes / seconds / (1024 * 1024) << " MB/s\n";
+	out << "fuzz: journal appends " << journalChecks << ", window loads " << windowLoads << "\n";
+	out << "fuzz: " << failures << " failures\n";
+	return failures == 0 ? 0 : 1;
+}
+
+/**
+    @brief  ,      
+	    10 .     
+	,       .
+    @param  settingsFile  -    ;    
+	 .
+    @param  lowMemoryMode -    .
+    @retval               - ;    .
+**/
+CustomMainWindow* startWindow(const QString& settingsFile, bool lowMemoryMode) {
+	QFile::remove(settingsFile);
+	QFile::remove(settingsFile + ".journal");
+	QFile::remove(settingsFile + ".compacting");
+	{
+		SettingsStore settings(settingsFile);
+		settings.setValue("theme", "lightToggle");
+		settings.commit();
+	}
+	CustomMainWindow* window = new CustomMainWindow(nullptr, lowMemoryMode, false, settingsFile);
+	window->show();
+	QElapsedTimer timer;
+	timer.start();
+	while (!window->isStartupComplete() && timer.elapsed() < 10000) {
+		QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+	}
+	return window;
+}
+
+/**
+    @brief  , ,     
+	   ,    
+	 .     , 
+	   ,    
+	 .
+    @param  out -    .
+    @retval     -   : 1,     
+	   .
+**/
+int benchmarkSetpoint(QTextStream& out) {
+	QString settingsFile = QDir::tempPath() + "/conditioner_setpoint_settings.xml";
+	CustomMainWindow* window = startWindow(settingsFile, false);
+	int changed = 0;
+	if (!window->isStartupComplete()) {
+		out << "setpoint: startup did not complete\n";
+		changed++;
+	}
+	else {
+		window->findChild<QPushButton*>("powerButton")->click();
+		double sensor = window->getRoomTemperature();
+		const char* const buttons[] = { "increaseButton", "increaseButton", "decreaseButton", "fahrenheitButton", "kelvinButton", "celsiusButton" };
+		for (const char* name : buttons) {
+			window->findChild<QPushButton*>(name)->click();
+			QCoreApplication::processEvents();
+			bool unchanged = window->getRoomTemperature() == sensor;
+			out << "setpoint: " << name << " sensor " << (unchanged ? "unchanged" : "CHANGED") << "\n";
+			changed += !unchanged;
+		}
+	}
+	window->close();
+	delete window;
+	QFile::remove(settingsFile);
+	QFile::remove(settingsFile + ".journal");
+	QFile::remove(settingsFile + ".compacting");
+	return changed == 0 ? 0 : 1;
+}
+
+/**
+    @brief  ,     
+	    :  , 
+	  ,      
+	 LOW_MEMORY_RSS_BUDGET.
+    @param  out -    .
+    @retval     -   : 1,     
+	   .
+**/
+int benchmarkMemory(QTextStream& out) {
+	QPixmapCache::setCacheLimit(LOW_MEMORY_PIXMAP_CACHE_LIMIT);
+	QString settingsFile = QDir::tempPath() + "/conditioner_memory_settings.xml";
+	CustomMainWindow* window = startWindow(settingsFile, true);
+	bool started = window->isStartupComplete();
+	if (started) {
+		QPushButton* powerButton = window->findChild<QPushButton*>("powerButton");
+		powerButton->click();
+		QCoreApplication::processEvents();
+		powerButton->click();
+		QCoreApplication::processEvents();
+	}
+	else {
+		out << "memory: startup did not complete\n";
+	}
+	out << window->getMemoryReport() << "\n";
+	bool withinBudget = MemoryReport::getResidentBytes() <= LOW_MEMORY_RSS_BUDGET;
+	out << "memory: budget " << LOW_MEMORY_RSS_BUDGET / 1024 << " KiB " << (withinBudget ? "met" : "EXCEEDED") << "\n";
+	window->close();
+	delete window;
+	QFile::remove(settingsFile);
+	QFile::remove(settingsFile + ".journal");
+	QFile::remove(settingsFile + ".compacting");
+	return started && withinBudget ? 0 : 1;
+}
+
+}
+
+/**
+    @brief  ,      .
+    @param  name      -  .
+    @param  arguments -    .
+    @retval           -   : 0  , 1 
+	     .
+**/
+int runBenchmark(const QString& name, const QStringList& arguments) {
+	QTextStream out(stdout);
+	if (name == "energy") {
+		return benchmarkEnergy(out);
+	}
+	if (name == "csv") {
+		return benchmarkSensorLog(out, arguments);
+	}
+	if (name == "undo") {
+		return benchmarkUndo(out, arguments);
+	}
+	if (name == "rules") {
+		return benchmarkRules(out, arguments);
+	}
+	if (name == "scaling") {
+		return benchmarkScaling(out, arguments);
+	}
+	if (name == "segment") {
+		return benchmarkStateSegment(out, arguments);
+	}
+	if (name == "telemetry") {
+		return benchmarkTelemetry(out, arguments);
+	}
+	if (name == "idle") {
+		return benchmarkIdle(out, arguments);
+	}
+	if (name == "settings") {
+		return benchmarkSettings(out, arguments);
+	}
+	if (name == "parse") {
+		return benchmarkSettingsParse(out, arguments);
+	}
+	if (name == "fuzz") {
+		return benchmarkSettingsFuzz(out, arguments);
+	}
+	if (name == "setpoint") {
+		return benchmarkSetpoint(out);
+	}
+	if (name == "memory") {
+		return benchmarkMemory(out);
+	}
+	out << "Unknown benchmark: " << name << "\n";
+	return 1;
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <QStringList>
+
+/**
+*     .
+*    : Conditioner --benchmark <>.
+**/
+
+int runBenchmark(const QString& name, const QStringList& arguments);
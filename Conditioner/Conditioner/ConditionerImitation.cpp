@@ -3,6 +3,11 @@
 #include "AppData.h"
 #include <QObject>
 #include <QDebug>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QApplication>
+#include <QGridLayout>
+#include <QSignalBlocker>
 
 /**
     @brief  -  .
@@ -27,49 +32,158 @@ ConditionerImitation::ConditionerImitation(const QString& temperature, const QSt
     @brief  -  .
 **/
 ConditionerImitation::~ConditionerImitation() {
-	delete humidityValidator;
-	delete pressureValidator;
+	delete sensorLogReader;
 	delete ui;
 }
 
 /**
     @brief ,       
-	.    .
+	.     , 
+	     .    .
 **/
 void ConditionerImitation::initializeFieldsAndButtons() {
-	humidityValidator = new QIntValidator(HUMIDITY_MIN, HUMIDITY_MAX);
-	ui->humidityEdit->setValidator(humidityValidator);
-	pressureValidator = new QIntValidator(-1000000, 10000000);
-	ui->pressureEdit->setValidator(pressureValidator);
+	ui->humidityEdit->setValidator(getHumidityValidator());
+	ui->pressureEdit->setValidator(getPressureValidator());
 	connect(parentPtr, SIGNAL(temperatureChanged(QString&)), this, SLOT(setTemperature(QString&)));
 	connect(ui->temperatureBox, SIGNAL(valueChanged(double)), parentPtr, SLOT(getTemperatureEdited(double)));
 	connect(ui->humidityEdit, SIGNAL(textEdited(const QString&)), parentPtr, SLOT(getHumidityEdited(const QString&)));
 	connect(parentPtr, SIGNAL(pressureChanged(QString&)), this, SLOT(setPressure(QString&)));
 	connect(ui->pressureEdit, SIGNAL(textEdited(const QString&)), parentPtr, SLOT(getPressureEdited(const QString&)));
 	connect(parentPtr, SIGNAL(directionChanged(QString&)), this, SLOT(setDirection(QString&)));
-	connect(ui->sendInnerIssueButton, SIGNAL(clicked(bool)), parentPtr, SLOT(getInnerBlockError()));
-	connect(ui->solveInnerIssueButton, SIGNAL(clicked(bool)), parentPtr, SLOT(getInnerBlockOk()));
-	connect(ui->sendOuterIssueButton, SIGNAL(clicked(bool)), parentPtr, SLOT(getOuterBlockError()));
-	connect(ui->solveOuterIssueButton, SIGNAL(clicked(bool)), parentPtr, SLOT(getOuterBlockOk()));
+	connect(this, SIGNAL(sensorSampleRead(double, double, double)), parentPtr, SLOT(getSensorSample(double, double, double)));
+
+	faultPanelButton = new QPushButton(faultPanelText, this);
+	faultPanelButton->setCheckable(true);
+	ui->gridLayout->addWidget(faultPanelButton, 5, 1, 1, 2);
+	connect(faultPanelButton, &QPushButton::toggled, this, &ConditionerImitation::switchFaultPanel);
+
+	sensorLogButton = new QPushButton(sensorLogStartText, this);
+	ui->gridLayout->addWidget(sensorLogButton, ui->gridLayout->rowCount(), 0, 1, ui->gridLayout->columnCount());
+	connect(sensorLogButton, &QPushButton::clicked, this, &ConditionerImitation::switchSensorLogPlayback);
+}
+
+/**
+    @brief ,      
+	.     .
+    @param visible -   .
+**/
+void ConditionerImitation::switchFaultPanel(bool visible) {
+	if (faultPanel == nullptr) {
+		faultPanel = new QWidget(this);
+		QGridLayout* layout = new QGridLayout(faultPanel);
+		layout->setContentsMargins(0, 0, 0, 0);
+		const QString texts[] = { sendInnerIssueText, solveInnerIssueText, sendOuterIssueText, solveOuterIssueText };
+		const char* members[] = { SLOT(getInnerBlockError()), SLOT(getInnerBlockOk()), SLOT(getOuterBlockError()), SLOT(getOuterBlockOk()) };
+		for (int i = 0; i < 4; i++) {
+			QPushButton* button = new QPushButton(texts[i], faultPanel);
+			button->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Minimum);
+			layout->addWidget(button, i / 2, i % 2);
+			connect(button, SIGNAL(clicked(bool)), parentPtr, members[i]);
+		}
+		ui->gridLayout->addWidget(faultPanel, 7, 1, 1, 2);
+	}
+	faultPanel->setVisible(visible);
+}
+
+/**
+    @brief  ,    ,   
+	 .   .
+    @retval  -  .
+**/
+QIntValidator* ConditionerImitation::getHumidityValidator() {
+	static QIntValidator* validator = new QIntValidator(HUMIDITY_MIN, HUMIDITY_MAX, qApp);
+	return validator;
+}
+
+/**
+    @brief  ,    ,   
+	 .   .
+    @retval  -  .
+**/
+QIntValidator* ConditionerImitation::getPressureValidator() {
+	static QIntValidator* validator = new QIntValidator(-1000000, 10000000, qApp);
+	return validator;
+}
+
+/**
+    @brief ,     ,
+	 ,    . 
+	    .
+**/
+void ConditionerImitation::switchSensorLogPlayback() {
+	if (sensorLogReader != nullptr) {
+		stopSensorLog();
+		return;
+	}
+	QString path = QFileDialog::getOpenFileName(this, sensorLogDialogTitle, QString(), sensorLogFileFilter);
+	if (path.isEmpty()) {
+		return;
+	}
+	sensorLogReader = new SensorLogReader(path);
+	if (!sensorLogReader->open()) {
+		QMessageBox::warning(this, appTitle, sensorLogOpenWarningMessage);
+		delete sensorLogReader;
+		sensorLogReader = nullptr;
+		return;
+	}
+	if (sensorLogTimer == nullptr) {
+		sensorLogTimer = new QTimer(this);
+		sensorLogTimer->setInterval(SENSOR_LOG_PLAYBACK_INTERVAL);
+		connect(sensorLogTimer, &QTimer::timeout, this, &ConditionerImitation::playSensorLog);
+	}
+	sensorLogButton->setText(sensorLogStopText);
+	sensorLogTimer->start();
+}
+
+/**
+    @brief ,       
+	  .   :   
+	  ,   SENSOR_LOG_DECIMATION_INTERVAL
+	 .     .
+**/
+void ConditionerImitation::playSensorLog() {
+	SensorSample sample;
+	if (sensorLogReader->read(&sample, 1, SENSOR_LOG_DECIMATION_INTERVAL) == 0) {
+		stopSensorLog();
+		return;
+	}
+	ui->humidityEdit->setText(QString::number(qRound(sample.humidity)));
+	emit sensorSampleRead(sample.temperature, sample.humidity, sample.pressure);
+}
+
+/**
+    @brief ,     .
+**/
+void ConditionerImitation::stopSensorLog() {
+	sensorLogTimer->stop();
+	delete sensorLogReader;
+	sensorLogReader = nullptr;
+	sensorLogButton->setText(sensorLogStartText);
 }
 
 /**
     @brief         
-		    .
+		    .  
+	,        
+	  .
     @param newTemperature -    , 
 	   .
 **/
 void ConditionerImitation::setTemperature(QString& newTemperature) {
+	QSignalBlocker blocker(ui->temperatureBox);
 	ui->temperatureBox->setValue(newTemperature.toDouble());
 }
 
 /**
 	@brief         
-	     .
+	     .  
+	,         
+	.
 	@param newPressure -    , 
 	   .
 **/
 void ConditionerImitation::setPressure(QString& newPressure) {
+	QSignalBlocker blocker(ui->pressureEdit);
 	ui->pressureEdit->setText(newPressure);
 }
 
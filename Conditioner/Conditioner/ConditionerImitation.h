@@ -1,6 +1,9 @@
 #pragma once
 #include <QWidget>
+#include <QPushButton>
+#include <QTimer>
 #include "ui_ConditionerImitation.h"
+#include "SensorLogReader.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class ConditionerImitationClass; };
@@ -21,6 +24,9 @@ public:
 	ConditionerImitation(const QString& temperature, const QString& humidity, const QString& pressure, QWidget* parentPtr, QWidget* parent = nullptr);
 	~ConditionerImitation();
 
+signals:
+	void sensorSampleRead(double temperature, double humidity, double pressure);
+
 public slots:
 	void setTemperature(QString& newTemperature);
 	void setPressure(QString& newPressure);
@@ -29,8 +35,19 @@ public slots:
 private:
 	void initializeFieldsAndButtons();
 
-	QIntValidator* humidityValidator;
-	QIntValidator* pressureValidator;
+	void switchSensorLogPlayback();
+	void playSensorLog();
+	void stopSensorLog();
+	void switchFaultPanel(bool visible);
+
+	static QIntValidator* getHumidityValidator();
+	static QIntValidator* getPressureValidator();
+
+	QPushButton* faultPanelButton;
+	QWidget* faultPanel = nullptr;
+	QPushButton* sensorLogButton;
+	QTimer* sensorLogTimer = nullptr;
+	SensorLogReader* sensorLogReader = nullptr;
 
 	QWidget* parentPtr;
 	Ui::ConditionerImitationClass* ui;
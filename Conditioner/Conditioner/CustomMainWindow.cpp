@@ -1,25 +1,105 @@
 #include "CustomMainWindow.h"
 #include "AppData.h"
+#include "IconCache.h"
 #include <QFile>
 #include <QButtonGroup>
 #include <QIcon>
 #include <QCloseEvent>
-#include <QXmlStreamWriter>
-#include <QXmlStreamReader>
 #include <QMessageBox>
 #include <QDebug>
+#include <QDateTime>
+#include <QAbstractButton>
+#include <QTimer>
 
 /**
-    @brief     .
-    @param parent -     , 
+    @brief     .  
+	,     :  ,   
+	     .  
+	  completeStartup()    .
+    @param parent        -     , 
 	  QWidget,    nullptr.
+    @param lowMemoryMode -    ,    false.
+    @param viewerMode    -   ,    
+	 ,  ,    false.
+    @param settingsFile  -    ;   ,   settingsPath.
 **/
-CustomMainWindow::CustomMainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::CustomMainWindowClass()) {
+CustomMainWindow::CustomMainWindow(QWidget* parent, bool lowMemoryMode, bool viewerMode, const QString& settingsFile)
+	: QMainWindow(parent), settingsFile(settingsFile.isEmpty() ? settingsPath : settingsFile), temperatureChange(TEMPERATURE_HYSTERESIS),
+	humidityChange(HUMIDITY_HYSTERESIS), pressureChange(PRESSURE_HYSTERESIS), powerChange(POWER_HYSTERESIS), lowMemoryMode(lowMemoryMode),
+	viewerMode(viewerMode), ui(new Ui::CustomMainWindowClass()) {
+	startupTrace.record("application");
 	ui->setupUi(this);
-	initializeStyles();
+	startupTrace.record("widgets");
+	memoryReport.record("widgets");
 	initializeButtons();
+	startupTrace.record("buttons");
+	memoryReport.record("buttons");
 	loadSettings();
+	startupTrace.record("settings");
+	memoryReport.record("settings");
+	initializeIcons();
+	startupTrace.record("icons");
+	memoryReport.record("icons");
 	resizeBuffer = QSize(0, 0);
+	ui->centralWidget->installEventFilter(this);
+}
+
+/**
+    @brief ,      : 
+	,     ,    ,
+	       .
+	    ,    .
+**/
+void CustomMainWindow::completeStartup() {
+	memoryReport.record("first frame");
+	initializeEnergyModel();
+	startupTrace.record("energy");
+	memoryReport.record("energy");
+	initializeStateHistory();
+	startupTrace.record("history");
+	memoryReport.record("history");
+	initializeFaultRules();
+	startupTrace.record("faults");
+	memoryReport.record("faults");
+	initializeStateSegment();
+	startupTrace.record("segment");
+	memoryReport.record("segment");
+	initializeTelemetry();
+	startupTrace.record("telemetry");
+	memoryReport.record("telemetry");
+	initializeScheduler();
+	startupTrace.record("scheduler");
+	memoryReport.record("scheduler");
+	startupComplete = true;
+	updateSetpoint();
+	updateDirection();
+	updateEnergyToolTip();
+	stateHistory->reset(captureState());
+	publishState();
+	startupTrace.record("state");
+	startupTrace.mark("interactive");
+	startupTrace.write(startupTracePath);
+	checkMemoryBudget();
+	if (settingsWarning) {
+		QMessageBox::warning(this, appTitle, loadSettingsWarningMessage.toUtf8());
+	}
+}
+
+/**
+    @brief    ,   
+	   .   
+	    ,       .
+    @param  watched - ,   .
+    @param  event   - .
+    @retval         -   -.
+**/
+bool CustomMainWindow::eventFilter(QObject* watched, QEvent* event) {
+	if (watched == ui->centralWidget && event->type() == QEvent::Paint) {
+		ui->centralWidget->removeEventFilter(this);
+		startupTrace.mark("first frame");
+		QTimer::singleShot(0, this, &CustomMainWindow::completeStartup);
+	}
+	return QMainWindow::eventFilter(watched, event);
 }
 
 /**
@@ -30,40 +110,86 @@ CustomMainWindow::~CustomMainWindow() {
 	delete temperatureGroup;
 	delete pressureGroup;
 	delete directionGroup;
+	delete energyModel;
+	delete energyAnalytics;
+	delete undoShortcut;
+	delete redoShortcut;
+	delete stateHistory;
+	delete faultRuleEngine;
+	delete telemetryStore;
+	delete settingsStore;
+	delete updateScheduler;
+	delete stateSegment;
 	delete ui;
+	IconCache::clear();
 }
 
 /**
-    @brief ,      .
-	   .
+    @brief  ,     .
+    @param  path -    .
+    @retval      - ,      QSS.
 **/
-void CustomMainWindow::initializeStyles() {
-	QFile styleFile(lightStyleSheetPath);
+QString CustomMainWindow::readStyleSheet(const QString& path) {
+	QFile styleFile(path);
 	styleFile.open(QFile::ReadOnly);
-	lightStyle = styleFile.readAll();
-	styleFile.close();
-	styleFile.setFileName(darkStyleSheetPath);
-	styleFile.open(QFile::ReadOnly);
-	darkStyle = styleFile.readAll();
+	QString style = styleFile.readAll();
 	styleFile.close();
+	return style;
 }
 
 /**
     @brief  ,       .
+	      ,   
+	    .
     @retval  - ,       QSS.
 **/
 QString& CustomMainWindow::getLightStyle() {
+	if (lightStyle.isEmpty()) {
+		lightStyle = readStyleSheet(lightStyleSheetPath);
+	}
 	return this->lightStyle;
 }
 
 /**
     @brief  ,       .
+	      .
     @retval  - ,       QSS.
 **/
 QString& CustomMainWindow::getDarkStyle() {
+	if (darkStyle.isEmpty()) {
+		darkStyle = readStyleSheet(darkStyleSheetPath);
+	}
 	return this->darkStyle;
 }
 
+/**
+    @brief  , ,    .
+    @retval  -  true,  ,    
+	, ,  false.
+**/
+bool CustomMainWindow::isStartupComplete() const {
+	return startupComplete;
+}
+
+/**
+    @brief  ,     , 
+	    .
+    @retval  -    .
+**/
+double CustomMainWindow::getRoomTemperature() const {
+	return roomTemperature;
+}
+
+/**
+    @brief  ,     
+	    .
+    @retval  -  .
+**/
+QString CustomMainWindow::getMemoryReport() const {
+	return memoryReport.format() + QString("\nicon cache: %1 KiB in %2 pixmaps").arg(IconCache::getBytes() / 1024)
+		.arg(IconCache::getCount());
+}
+
 /**
     @brief ,      .
 	   .
@@ -99,22 +225,155 @@ void CustomMainWindow::initializeButtons() {
 	connect(ui->rightDirButton, &QPushButton::toggled, this, &CustomMainWindow::changeDirectionToRight);
 }
 
+/**
+    @brief ,     .
+	      ,
+	    .
+	   .
+**/
+void CustomMainWindow::initializeEnergyModel() {
+	energyModel = new EnergyModel(1);
+	energyAnalytics = new EnergyAnalytics(1, ENERGY_HISTORY_DAYS);
+	bool ok = false;
+	double consumed = settingsStore->value("energyMeter").toDouble(&ok);
+	energyModel->setConsumedEnergy(0, ok && qIsFinite(consumed) && consumed >= 0 ? consumed : 0.0);
+}
+
+/**
+    @brief ,       
+	     .    .
+**/
+void CustomMainWindow::initializeStateHistory() {
+	stateHistory = new StateHistory(UNDO_HISTORY_LIMIT);
+	undoShortcut = new QShortcut(QKeySequence::Undo, this);
+	redoShortcut = new QShortcut(QKeySequence::Redo, this);
+	connect(undoShortcut, &QShortcut::activated, this, &CustomMainWindow::undoChange);
+	connect(redoShortcut, &QShortcut::activated, this, &CustomMainWindow::redoChange);
+}
+
+/**
+    @brief ,     
+	.    .
+**/
+void CustomMainWindow::initializeFaultRules() {
+	faultRuleEngine = new FaultRuleEngine(1);
+	faultRuleEngine->setRules(FaultRuleEngine::getDefaultRules());
+}
+
+/**
+    @brief ,      ,
+	     -.
+	    .    
+	 ,    . 
+	  .
+**/
+void CustomMainWindow::initializeStateSegment() {
+	stateSegment = new StateSegment(stateSegmentKey);
+	if (!viewerMode) {
+		stateSegment->create();
+		return;
+	}
+	ui->centralWidget->setAttribute(Qt::WA_TransparentForMouseEvents);
+	for (QAbstractButton* button : ui->centralWidget->findChildren<QAbstractButton*>()) {
+		button->setFocusPolicy(Qt::NoFocus);
+	}
+	undoShortcut->setEnabled(false);
+	redoShortcut->setEnabled(false);
+}
+
+/**
+    @brief ,     ,  
+	       
+	.      .
+	   .
+**/
+void CustomMainWindow::initializeTelemetry() {
+	telemetryStore = new TelemetryStore(telemetryPath);
+	if (!viewerMode) {
+		telemetryStore->open();
+	}
+}
+
+/**
+    @brief ,     
+	.      
+	 ,   ;  
+	    .   
+	     STATE_POLL_INTERVAL:  
+	,     ,  
+	 ,       , 
+	  STATE_POLL_MAX_INTERVAL.    .
+**/
+void CustomMainWindow::initializeScheduler() {
+	updateScheduler = new UpdateScheduler(this);
+	if (viewerMode) {
+		updateScheduler->addTask(STATE_POLL_INTERVAL, STATE_POLL_MAX_INTERVAL, [this] { return pollState(); });
+		updateScheduler->start();
+		return;
+	}
+	updateScheduler->addTask(ENERGY_UPDATE_INTERVAL, ENERGY_MAX_UPDATE_INTERVAL, [this] {
+		updateEnergy();
+		return powerChange.update(energyModel->getPowerDraw(0));
+	});
+	updateScheduler->addTask(FAULT_CHECK_INTERVAL, FAULT_MAX_CHECK_INTERVAL, [this] { return evaluateFaultRules(); });
+}
+
+/**
+    @brief ,    .  
+	   ,       
+	  :     
+	  .    .
+**/
+void CustomMainWindow::initializeIcons() {
+	if (lowMemoryMode) {
+		ui->innerBlock->setScaledContents(false);
+		ui->outerBlock->setScaledContents(false);
+		ui->humidityIcon->setScaledContents(false);
+	}
+	setButtonIcon(ui->darkToggle, moonLightIcon);
+	setButtonIcon(ui->powerButton, powerIcon);
+	setThemeIcons();
+}
+
+/**
+    @brief ,   .   
+	       ,  .
+    @param button - .
+    @param path   -    .
+**/
+void CustomMainWindow::setButtonIcon(QAbstractButton* button, const QString& path) {
+	if (lowMemoryMode) {
+		button->setIcon(IconCache::getIcon(path, button->iconSize(), button->devicePixelRatioF()));
+	}
+	else {
+		button->setIcon(QIcon(path));
+	}
+}
+
+/**
+    @brief ,   .   
+	        .
+    @param label - .
+    @param path  -   .
+**/
+void CustomMainWindow::setLabelPixmap(QLabel* label, const QString& path) {
+	if (lowMemoryMode) {
+		label->setPixmap(IconCache::getPixmap(path, label->size(), label->devicePixelRatioF()));
+	}
+	else {
+		label->setPixmap(QPixmap(path));
+	}
+}
+
 /**
     @brief ,     ,
 	  .
 **/
 void CustomMainWindow::turnOnLightMode() {
 	if (ui->lightToggle->isChecked()) {
-		this->setStyleSheet(lightStyle);
-		ui->lightToggle->setIcon(QIcon(sunLightIcon));
-		ui->innerBlock->setPixmap(QPixmap(innerBlockLightIcon));
-		ui->outerBlock->setPixmap(QPixmap(outerBlockLightIcon));
-		ui->increaseButton->setIcon(QIcon(increaseLightIcon));
-		ui->decreaseButton->setIcon(QIcon(decreaseLightIcon));
-		ui->humidityIcon->setPixmap(QPixmap(dropLightIcon));
-		ui->leftDirButton->setIcon(QIcon(leftDirLightIcon));
-		ui->centerDirButton->setIcon(QIcon(centerDirLightIcon));
-		ui->rightDirButton->setIcon(QIcon(rightDirLightIcon));
+		this->setStyleSheet(getLightStyle());
+		setThemeIcons();
+		publishState();
 	}
 }
 
@@ -124,16 +383,38 @@ void CustomMainWindow::turnOnLightMode() {
 **/
 void CustomMainWindow::turnOnDarkMode() {
 	if (ui->darkToggle->isChecked()) {
-		this->setStyleSheet(darkStyle);
-		ui->lightToggle->setIcon(QIcon(sunDarkIcon));
-		ui->innerBlock->setPixmap(QPixmap(innerBlockDarkIcon));
-		ui->outerBlock->setPixmap(QPixmap(outerBlockDarkIcon));
-		ui->increaseButton->setIcon(QIcon(increaseDarkIcon));
-		ui->decreaseButton->setIcon(QIcon(decreaseDarkIcon));
-		ui->humidityIcon->setPixmap(QPixmap(dropDarkIcon));
-		ui->leftDirButton->setIcon(QIcon(leftDirDarkIcon));
-		ui->centerDirButton->setIcon(QIcon(centerDirDarkIcon));
-		ui->rightDirButton->setIcon(QIcon(rightDirDarkIcon));
+		this->setStyleSheet(getDarkStyle());
+		setThemeIcons();
+		publishState();
+	}
+}
+
+/**
+    @brief ,  ,  
+	.       .
+**/
+void CustomMainWindow::setThemeIcons() {
+	if (ui->lightToggle->isChecked()) {
+		setButtonIcon(ui->lightToggle, sunLightIcon);
+		setLabelPixmap(ui->innerBlock, innerBlockLightIcon);
+		setLabelPixmap(ui->outerBlock, outerBlockLightIcon);
+		setButtonIcon(ui->increaseButton, increaseLightIcon);
+		setButtonIcon(ui->decreaseButton, decreaseLightIcon);
+		setLabelPixmap(ui->humidityIcon, dropLightIcon);
+		setButtonIcon(ui->leftDirButton, leftDirLightIcon);
+		setButtonIcon(ui->centerDirButton, centerDirLightIcon);
+		setButtonIcon(ui->rightDirButton, rightDirLightIcon);
+	}
+	else {
+		setButtonIcon(ui->lightToggle, sunDarkIcon);
+		setLabelPixmap(ui->innerBlock, innerBlockDarkIcon);
+		setLabelPixmap(ui->outerBlock, outerBlockDarkIcon);
+		setButtonIcon(ui->increaseButton, increaseDarkIcon);
+		setButtonIcon(ui->decreaseButton, decreaseDarkIcon);
+		setLabelPixmap(ui->humidityIcon, dropDarkIcon);
+		setButtonIcon(ui->leftDirButton, leftDirDarkIcon);
+		setButtonIcon(ui->centerDirButton, centerDirDarkIcon);
+		setButtonIcon(ui->rightDirButton, rightDirDarkIcon);
 	}
 }
 
@@ -143,119 +424,246 @@ void CustomMainWindow::turnOnDarkMode() {
 	     
 	  . ,  
 	       
-	.
+	.      .
 **/
 void CustomMainWindow::switchPower() {
+	if (!startupComplete) {
+		return;
+	}
 	if (!power) {
 		power = true;
 		ui->controlHide->hide();
+		QString humidity = ui->humidityLabel->text();
+		humidity.remove('%');
+		roomTemperature = toCelsius(ui->temperatureLabel->text().toDouble());
+		roomHumidity = humidity.toDouble();
+		roomPressure = toPascal(ui->pressureLabel->text().toDouble());
+		energyModel->setRoomTemperature(0, roomTemperature);
+		energyModel->setPower(0, true);
+		energyClock.start();
+		faultRuleEngine->reset();
+		faultClock.start();
+		updateScheduler->start();
 		subWindow = new ConditionerImitation(ui->temperatureLabel->text(), ui->humidityLabel->text(), ui->pressureLabel->text(), this);
 		subWindow->show();
+		memoryReport.record("imitation");
+		publishState();
+		checkMemoryBudget();
 	}
 	else {
 		power = false;
 		ui->controlHide->show();
 		subWindow->close();
 		delete subWindow;
+		memoryReport.record("imitation");
+		updateEnergy();
+		updateScheduler->stop();
+		energyModel->setPower(0, false);
+		updateEnergyToolTip();
+		publishState();
+		checkMemoryBudget();
+	}
+}
+
+/**
+    @brief ,      .
+	     ;   
+	   memory.
+**/
+void CustomMainWindow::checkMemoryBudget() {
+	if (!lowMemoryMode) {
+		return;
+	}
+	if (MemoryReport::getResidentBytes() > LOW_MEMORY_RSS_BUDGET) {
+		qWarning().noquote() << QString("resident memory exceeds budget of %1 KiB").arg(LOW_MEMORY_RSS_BUDGET / 1024);
+	}
+}
+
+/**
+    @brief ,     
+	-.        
+	 .
+**/
+void CustomMainWindow::publishState() {
+	if (!startupComplete || !stateSegment->isWriter()) {
+		return;
 	}
+	SharedPanelState state;
+	StateSegment::setText(state.temperature, ui->temperatureLabel->text());
+	StateSegment::setText(state.humidity, ui->humidityLabel->text());
+	StateSegment::setText(state.pressure, ui->pressureLabel->text());
+	StateSegment::setText(state.theme, modeGroup->checkedButton()->objectName());
+	StateSegment::setText(state.temperatureMode, temperatureGroup->checkedButton()->objectName());
+	StateSegment::setText(state.pressureMode, pressureGroup->checkedButton()->objectName());
+	StateSegment::setText(state.direction, directionGroup->checkedButton()->objectName());
+	state.consumedEnergy = energyModel->getConsumedEnergy(0);
+	state.publishedAt = 0;
+	state.power = power;
+	state.faults = indicatedFaults;
+	stateSegment->publish(state);
+}
+
+/**
+    @brief ,       
+	   .     
+	,     . ,  
+	     , . 
+	.
+    @retval  -  true,    ,  false.
+**/
+bool CustomMainWindow::pollState() {
+	if (!stateSegment->isAttached() && !stateSegment->attach()) {
+		return false;
+	}
+	SharedPanelState state;
+	if (!stateSegment->read(state, stateSequence)) {
+		return false;
+	}
+	ZoneState zone;
+	zone.temperature = StateSegment::getText(state.temperature);
+	zone.temperatureMode = StateSegment::getText(state.temperatureMode);
+	zone.pressureMode = StateSegment::getText(state.pressureMode);
+	zone.direction = StateSegment::getText(state.direction);
+	QAbstractButton* themeButton = findGroupButton(modeGroup, StateSegment::getText(state.theme));
+	if (themeButton == nullptr
+		|| findGroupButton(temperatureGroup, zone.temperatureMode) == nullptr
+		|| findGroupButton(pressureGroup, zone.pressureMode) == nullptr
+		|| findGroupButton(directionGroup, zone.direction) == nullptr) {
+		return false;
+	}
+	themeButton->setChecked(true);
+	ControllerState controllerState;
+	controllerState.zones = controllerState.zones.append(zone);
+	applyState(controllerState);
+	ui->humidityLabel->setText(StateSegment::getText(state.humidity));
+	ui->pressureLabel->setText(StateSegment::getText(state.pressure));
+	if (bool(state.power) != power) {
+		power = state.power;
+		if (power) {
+			ui->controlHide->hide();
+		}
+		else {
+			ui->controlHide->show();
+		}
+	}
+	if (state.faults & InnerBlockFault) {
+		getInnerBlockError();
+	}
+	else {
+		getInnerBlockOk();
+	}
+	if (state.faults & OuterBlockFault) {
+		getOuterBlockError();
+	}
+	else {
+		getOuterBlockOk();
+	}
+	energyModel->setConsumedEnergy(0, state.consumedEnergy);
+	updateEnergyToolTip();
+	return true;
 }
 
 /**
     @brief ,    
-	    .
+	    .   
+	  ,    .
 **/
 void CustomMainWindow::saveSettings() {
-	QFile settingsFile(settingsPath);
-	settingsFile.open(QFile::WriteOnly);
-	QXmlStreamWriter writer(&settingsFile);
-	writer.setAutoFormatting(true);
-	writer.writeStartDocument();
-	writer.writeStartElement("settings");
-	writer.writeStartElement(modeGroup->checkedButton()->objectName());
-	writer.writeCharacters("\n");
-	writer.writeEndElement();
-	writer.writeStartElement(ui->temperatureLabel->objectName());
-	writer.writeAttribute("text", ui->temperatureLabel->text());
-	writer.writeCharacters("\n");
-	writer.writeEndElement();
-	writer.writeStartElement(temperatureGroup->checkedButton()->objectName());
-	writer.writeCharacters("\n");
-	writer.writeEndElement();
-	writer.writeStartElement(ui->humidityLabel->objectName());
-	writer.writeAttribute("text", ui->humidityLabel->text());
-	writer.writeCharacters("\n");
-	writer.writeEndElement();
-	writer.writeStartElement(ui->pressureLabel->objectName());
-	writer.writeAttribute("text", ui->pressureLabel->text());
-	writer.writeCharacters("\n");
-	writer.writeEndElement();
-	writer.writeStartElement(pressureGroup->checkedButton()->objectName());
-	writer.writeCharacters("\n");
-	writer.writeEndElement();
-	writer.writeStartElement(directionGroup->checkedButton()->objectName());
-	writer.writeCharacters("\n");
-	writer.writeEndElement();
-	writer.writeEndElement();
-	writer.writeEndDocument();
-	settingsFile.close();
+	settingsStore->setValue("theme", modeGroup->checkedButton()->objectName());
+	settingsStore->setValue(SettingsStore::zoneKey(0, "temperature"), ui->temperatureLabel->text());
+	settingsStore->setValue(SettingsStore::zoneKey(0, "temperatureMode"), temperatureGroup->checkedButton()->objectName());
+	settingsStore->setValue(SettingsStore::zoneKey(0, "humidity"), ui->humidityLabel->text());
+	settingsStore->setValue(SettingsStore::zoneKey(0, "pressure"), ui->pressureLabel->text());
+	settingsStore->setValue(SettingsStore::zoneKey(0, "pressureMode"), pressureGroup->checkedButton()->objectName());
+	settingsStore->setValue(SettingsStore::zoneKey(0, "direction"), directionGroup->checkedButton()->objectName());
+	settingsStore->setValue("energyMeter", QString::number(energyModel->getConsumedEnergy(0), 'f', 6));
+	settingsStore->commit();
 }
 
 /**
     @brief ,    
-	     .
+	        .
+	      ,  
+	,     ,   
+	.  ,      
+	    ,  
+	       .   
+	     ,     
+	  .
 **/
 void CustomMainWindow::loadSettings() {
-	QFile settingsFile(settingsPath);
-	if (settingsFile.open(QFile::ReadOnly)) {
-		QXmlStreamReader reader(&settingsFile);
-		while (!reader.atEnd()) {
-			if (reader.isStartElement()) {
-				if (reader.name() == "lightToggle" || reader.name() == "darkToggle") {
-					ui->centralWidget->findChild<QPushButton*>(reader.name().toString())->setChecked(true);
-				}
-				else if (reader.name() == "temperatureLabel") {
-					ui->temperatureLabel->setText(reader.attributes().at(0).value().toString());
-				}
-				else if (reader.name() == "celsiusButton" || reader.name() == "fahrenheitButton" || reader.name() == "kelvinButton") {
-					ui->centralWidget->findChild<QPushButton*>(reader.name().toString())->setChecked(true);
-				}
-				else if (reader.name() == "humidityLabel") {
-					ui->humidityLabel->setText(reader.attributes().at(0).value().toString());
-				}
-				else if (reader.name() == "pressureLabel") {
-					ui->pressureLabel->setText(reader.attributes().at(0).value().toString());
-				}
-				else if (reader.name() == "mmHgButton" || reader.name() == "pascalButton") {
-					ui->centralWidget->findChild<QPushButton*>(reader.name().toString())->setChecked(true);
-				}
-				else if (reader.name() == "leftDirButton" || reader.name() == "centerDirButton" || reader.name() == "rightDirButton") {
-					ui->centralWidget->findChild<QPushButton*>(reader.name().toString())->setChecked(true);
-				}
-			}
-			reader.readNext();
-			if (reader.hasError()) {
-				QMessageBox::warning(this, appTitle, loadSettingsWarningMessage.toUtf8());
-				setDefaultSettings();
-				break;
-			}
-		}
+	settingsStore = new SettingsStore(settingsFile);
+	settingsWarning = !settingsStore->load();
+	checkGroupButton(modeGroup, settingsStore->value("theme"));
+	checkGroupButton(temperatureGroup, settingsStore->value(SettingsStore::zoneKey(0, "temperatureMode")));
+	checkGroupButton(pressureGroup, settingsStore->value(SettingsStore::zoneKey(0, "pressureMode")));
+	checkGroupButton(directionGroup, settingsStore->value(SettingsStore::zoneKey(0, "direction")));
+	setDefaultSettings();
+	bool ok = false;
+	QString temperature = settingsStore->value(SettingsStore::zoneKey(0, "temperature"));
+	double temperatureValue = temperature.toDouble(&ok);
+	if (ok && validateTemperature(temperatureValue)) {
+		ui->temperatureLabel->setText(temperature);
 	}
-	else {
-		QMessageBox::warning(this, appTitle, loadSettingsWarningMessage.toUtf8());
-		setDefaultSettings();
+	QString humidity = settingsStore->value(SettingsStore::zoneKey(0, "humidity"));
+	if (humidity.endsWith('%') && validateHumidity(humidity.chopped(1))) {
+		ui->humidityLabel->setText(humidity);
 	}
-	settingsFile.close();
+	QString pressure = settingsStore->value(SettingsStore::zoneKey(0, "pressure"));
+	double pressureValue = pressure.toDouble(&ok);
+	if (ok && validatePressure(pressureValue)) {
+		ui->pressureLabel->setText(pressure);
+	}
+}
+
+/**
+    @brief  ,      .
+    @param  group -  .
+    @param  name  -  .
+    @retval       -  true,       
+	,  false.
+**/
+bool CustomMainWindow::checkGroupButton(QButtonGroup* group, const QString& name) {
+	QAbstractButton* button = findGroupButton(group, name);
+	if (button == nullptr) {
+		return false;
+	}
+	button->setChecked(true);
+	return true;
+}
+
+/**
+    @brief  ,      .
+    @param  group -  .
+    @param  name  -  .
+    @retval       -   nullptr,        .
+**/
+QAbstractButton* CustomMainWindow::findGroupButton(QButtonGroup* group, const QString& name) {
+	for (QAbstractButton* button : group->buttons()) {
+		if (button->objectName() == name) {
+			return button;
+		}
+	}
+	return nullptr;
 }
 
 /**
     @brief ,     
-	 .
+	   ,      .
 **/
 void CustomMainWindow::setDefaultSettings() {
-	turnOnLightMode();
-	ui->celsiusButton->setChecked(true);
-	ui->mmHgButton->setChecked(true);
-	ui->centerDirButton->setChecked(true);
+	if (modeGroup->checkedButton() == nullptr) {
+		ui->lightToggle->setChecked(true);
+	}
+	if (temperatureGroup->checkedButton() == nullptr) {
+		ui->celsiusButton->setChecked(true);
+	}
+	if (pressureGroup->checkedButton() == nullptr) {
+		ui->mmHgButton->setChecked(true);
+	}
+	if (directionGroup->checkedButton() == nullptr) {
+		ui->centerDirButton->setChecked(true);
+	}
 }
 
 /**
@@ -282,8 +690,10 @@ void CustomMainWindow::increaseTemperature() {
 			ui->temperatureLabel->setText(QString::number(newValue));
 		}
 	}
+	updateSetpoint();
 	QString changedValue = QString::number(newValue);
 	emit temperatureChanged(changedValue);
+	recordState();
 }
 
 /**
@@ -310,8 +720,10 @@ void CustomMainWindow::decreaseTemperature() {
 			ui->temperatureLabel->setText(QString::number(newValue));
 		}
 	}
+	updateSetpoint();
 	QString changedValue = QString::number(newValue);
 	emit temperatureChanged(changedValue);
+	recordState();
 }
 
 /**
@@ -358,6 +770,7 @@ void CustomMainWindow::changeTemperatureModeFromCelsius() {
 		QString changedValue = QString::number(newValue);
 		ui->temperatureLabel->setText(changedValue);
 		emit temperatureChanged(changedValue);
+		recordState();
 	}
 }
 
@@ -378,6 +791,7 @@ void CustomMainWindow::changeTemperatureModeFromFahrenheit() {
 		QString changedValue = ui->celsiusButton->isChecked() ? QString::number(int(newValue)) : QString::number(newValue);
 		ui->temperatureLabel->setText(changedValue);
 		emit temperatureChanged(changedValue);
+		recordState();
 	}
 }
 
@@ -398,18 +812,35 @@ void CustomMainWindow::changeTemperatureModeFromKelvin() {
 		QString changedValue = ui->celsiusButton->isChecked() ? QString::number(int(newValue)) : QString::number(newValue);
 		ui->temperatureLabel->setText(changedValue);
 		emit temperatureChanged(changedValue);
+		recordState();
 	}
 }
 
 /**
-    @brief  ,     
-	  .
+    @brief  , ,     
+	    .
     @param  newValue -   .
     @retval          -  true,    
 	   ,   false.
 **/
 bool CustomMainWindow::validateHumidity(const QString& newValue) {
-	return newValue.toInt() >= HUMIDITY_MIN && newValue.toInt() <= HUMIDITY_MAX;
+	bool ok = false;
+	int value = newValue.toInt(&ok);
+	return ok && value >= HUMIDITY_MIN && value <= HUMIDITY_MAX;
+}
+
+/**
+    @brief  ,      
+	    .
+    @param  newValue -  .
+    @retval          -  true,    
+	  ,   false.
+**/
+bool CustomMainWindow::validatePressure(double newValue) {
+	if (ui->mmHgButton->isChecked()) {
+		return newValue >= MMHG_MIN && newValue <= MMHG_MAX;
+	}
+	return newValue >= PASCAL_MIN && newValue <= PASCAL_MAX;
 }
 
 /**
@@ -424,6 +855,7 @@ void CustomMainWindow::changePressureModeFromMmHg() {
 		QString changedValue = QString::number(newValue);
 		ui->pressureLabel->setText(changedValue);
 		emit pressureChanged(changedValue);
+		recordState();
 	}
 }
 
@@ -439,6 +871,7 @@ void CustomMainWindow::changePressureModeFromPascal() {
 		QString changedValue = QString::number(qRound(newValue));
 		ui->pressureLabel->setText(changedValue);
 		emit pressureChanged(changedValue);
+		recordState();
 	}
 }
 
@@ -448,8 +881,10 @@ void CustomMainWindow::changePressureModeFromPascal() {
 **/
 void CustomMainWindow::changeDirectionToLeft() {
 	if (ui->leftDirButton->isChecked()) {
+		updateDirection();
 		QString newDirection = "left";
 		emit directionChanged(newDirection);
+		recordState();
 	}
 }
 
@@ -459,8 +894,10 @@ void CustomMainWindow::changeDirectionToLeft() {
 **/
 void CustomMainWindow::changeDirectionToCenter() {
 	if (ui->centerDirButton->isChecked()) {
+		updateDirection();
 		QString newDirection = "center";
 		emit directionChanged(newDirection);
+		recordState();
 	}
 }
 
@@ -470,21 +907,283 @@ void CustomMainWindow::changeDirectionToCenter() {
 **/
 void CustomMainWindow::changeDirectionToRight() {
 	if (ui->rightDirButton->isChecked()) {
+		updateDirection();
 		QString newDirection = "right";
 		emit directionChanged(newDirection);
+		recordState();
+	}
+}
+
+/**
+    @brief  ,     , 
+	,   .
+    @param  value -     .
+    @retval       -     .
+**/
+double CustomMainWindow::toCelsius(double value) {
+	if (ui->fahrenheitButton->isChecked()) {
+		return (value - 32.0) / 1.8;
+	}
+	if (ui->kelvinButton->isChecked()) {
+		return value - 273.15;
+	}
+	return value;
+}
+
+/**
+    @brief  ,      
+	 ,  .
+    @param  value -     .
+    @retval       -     .
+**/
+double CustomMainWindow::fromCelsius(double value) {
+	if (ui->fahrenheitButton->isChecked()) {
+		return value * 1.8 + 32.0;
+	}
+	if (ui->kelvinButton->isChecked()) {
+		return value + 273.15;
+	}
+	return value;
+}
+
+/**
+    @brief  ,      ,
+	 ,  .
+    @param  value -      .
+    @retval       -    .
+**/
+double CustomMainWindow::toPascal(double value) {
+	return ui->mmHgButton->isChecked() ? value * 133.32 : value;
+}
+
+/**
+    @brief ,     ,
+	    .    
+	  ,      .
+**/
+void CustomMainWindow::updateSetpoint() {
+	if (!startupComplete) {
+		return;
+	}
+	energyModel->setSetpoint(0, toCelsius(ui->temperatureLabel->text().toDouble()));
+}
+
+/**
+    @brief ,     
+	.       , 
+	   ,      .
+**/
+void CustomMainWindow::updateDirection() {
+	if (!startupComplete) {
+		return;
+	}
+	if (ui->leftDirButton->isChecked()) {
+		energyModel->setDirection(0, AirDirection::Left);
+	}
+	else if (ui->rightDirButton->isChecked()) {
+		energyModel->setDirection(0, AirDirection::Right);
+	}
+	else {
+		energyModel->setDirection(0, AirDirection::Center);
+	}
+}
+
+/**
+    @brief ,      ,
+	   ,    
+	 .  ,   
+	.
+**/
+void CustomMainWindow::updateEnergy() {
+	float consumed = 0.0f;
+	energyModel->step(energyClock.restart() / 1000.0, &consumed);
+	energyAnalytics->accumulate(QDateTime::currentSecsSinceEpoch(), &consumed);
+	updateEnergyToolTip();
+	publishState();
+}
+
+/**
+    @brief ,     ,  
+	  ,  , 
+	,           .
+**/
+void CustomMainWindow::updateEnergyToolTip() {
+	QVector<float> daily;
+	QVector<float> weekly;
+	QVector<float> forecast;
+	qint64 today = QDateTime::currentSecsSinceEpoch() / 86400;
+	energyAnalytics->computeDailyTotals(today, daily);
+	energyAnalytics->computeWeeklyTotals(today, weekly);
+	energyAnalytics->computeDailyForecast(forecast);
+	ui->outerBlock->setToolTip(energyToolTipTemplate
+		.arg(qRound(energyModel->getLoad(0) * 100.0))
+		.arg(energyModel->getPowerDraw(0), 0, 'f', 2)
+		.arg(energyModel->getConsumedEnergy(0), 0, 'f', 3)
+		.arg(double(daily[0]), 0, 'f', 3)
+		.arg(double(weekly[0]), 0, 'f', 3)
+		.arg(double(forecast[0]), 0, 'f', 3));
+}
+
+/**
+    @brief  ,       
+	  .   ,   
+	,    .
+    @retval  -  .
+**/
+ControllerState CustomMainWindow::captureState() {
+	ZoneState zone;
+	zone.temperature = ui->temperatureLabel->text();
+	zone.temperatureMode = temperatureGroup->checkedButton()->objectName();
+	zone.pressureMode = pressureGroup->checkedButton()->objectName();
+	zone.direction = directionGroup->checkedButton()->objectName();
+	ControllerState state = stateHistory->current();
+	state.zones = state.zones.size() == 0 ? state.zones.append(zone) : state.zones.set(0, zone);
+	return state;
+}
+
+/**
+    @brief ,       ,
+	 . ,   
+	     ,   
+	    .   
+	  .    -, 
+	     .
+**/
+void CustomMainWindow::recordState() {
+	if (!startupComplete) {
+		return;
+	}
+	publishState();
+	updateScheduler->wake();
+	if (restoringState) {
+		return;
+	}
+	ControllerState state = captureState();
+	if (state.zones.at(0) != stateHistory->current().zones.at(0)) {
+		stateHistory->push(state);
+		saveSettings();
+	}
+}
+
+/**
+    @brief ,     . 
+	    ,  
+	  ,     
+	 .    ,
+	     .
+    @param state -   .
+**/
+void CustomMainWindow::applyState(const ControllerState& state) {
+	const ZoneState& zone = state.zones.at(0);
+	QString pressureMode = pressureGroup->checkedButton()->objectName();
+	QList<QAbstractButton*> buttons = temperatureGroup->buttons() + pressureGroup->buttons() + directionGroup->buttons();
+	for (QAbstractButton* button : buttons) {
+		button->blockSignals(true);
+	}
+	checkGroupButton(temperatureGroup, zone.temperatureMode);
+	checkGroupButton(pressureGroup, zone.pressureMode);
+	checkGroupButton(directionGroup, zone.direction);
+	for (QAbstractButton* button : buttons) {
+		button->blockSignals(false);
+	}
+	ui->temperatureLabel->setText(zone.temperature);
+
+	restoringState = true;
+	QString temperature = zone.temperature;
+	emit temperatureChanged(temperature);
+	if (zone.pressureMode != pressureMode) {
+		if (pressureMode == ui->mmHgButton->objectName()) {
+			changePressureModeFromMmHg();
+		}
+		else {
+			changePressureModeFromPascal();
+		}
+	}
+	changeDirectionToLeft();
+	changeDirectionToCenter();
+	changeDirectionToRight();
+	updateSetpoint();
+	restoringState = false;
+	publishState();
+}
+
+/**
+    @brief ,     .
+**/
+void CustomMainWindow::undoChange() {
+	if (stateHistory->canUndo()) {
+		applyState(stateHistory->undo());
+	}
+}
+
+/**
+    @brief ,     .
+**/
+void CustomMainWindow::redoChange() {
+	if (stateHistory->canRedo()) {
+		applyState(stateHistory->redo());
 	}
 }
 
+/**
+    @brief ,      
+	 ,   ;  
+	    .     
+	     ,   
+	 ,   .   
+	 .      
+	FAULT_CHECK_INTERVAL:     
+	 ,          .
+	 ,    .
+    @retval  -  true,      
+	   ,  false.
+**/
+bool CustomMainWindow::evaluateFaultRules() {
+	float temperature = float(roomTemperature);
+	float humidity = float(roomHumidity);
+	float pressure = float(roomPressure);
+	telemetryStore->append(0, { QDateTime::currentMSecsSinceEpoch() / 1000.0, temperature, humidity, pressure });
+	quint8 faults = 0;
+	bool changed = temperatureChange.update(temperature);
+	changed = humidityChange.update(humidity) || changed;
+	changed = pressureChange.update(pressure) || changed;
+	qint64 elapsed = qMin(faultClock.restart(), qint64(FAULT_CHECK_INTERVAL));
+	faultRuleEngine->evaluate(&temperature, &humidity, &pressure, elapsed / 1000.0f, &faults);
+	quint8 changedFaults = faults ^ detectedFaults;
+	if (changedFaults & InnerBlockFault) {
+		if (faults & InnerBlockFault) {
+			getInnerBlockError();
+		}
+		else {
+			getInnerBlockOk();
+		}
+	}
+	if (changedFaults & OuterBlockFault) {
+		if (faults & OuterBlockFault) {
+			getOuterBlockError();
+		}
+		else {
+			getOuterBlockOk();
+		}
+	}
+	detectedFaults = faults;
+	return changed || changedFaults != 0;
+}
+
 /**
     @brief      ,
 	       .
+	       ; ,
+	   ,    .
     @param event - ,   -, 
 	  .
 **/
 void CustomMainWindow::closeEvent(QCloseEvent* event) {
-	saveSettings();
-	if (power) {
-		switchPower();
+	if (!viewerMode && startupComplete) {
+		saveSettings();
+		if (power) {
+			switchPower();
+		}
 	}
 	event->accept();
 }
@@ -498,12 +1197,16 @@ void CustomMainWindow::closeEvent(QCloseEvent* event) {
 **/
 void CustomMainWindow::getTemperatureEdited(double newValue) {
 	if (validateTemperature(newValue)) {
+		roomTemperature = toCelsius(newValue);
+		energyModel->setRoomTemperature(0, roomTemperature);
 		if (ui->celsiusButton->isChecked()) {
 			ui->temperatureLabel->setText(QString::number(int(newValue)));
 		}
 		else {
 			ui->temperatureLabel->setText(QString::number(newValue));
 		}
+		publishState();
+		wakeScheduler();
 	}
 }
 
@@ -516,11 +1219,15 @@ void CustomMainWindow::getTemperatureEdited(double newValue) {
 **/
 void CustomMainWindow::getHumidityEdited(const QString& newValue) {
 	if (validateHumidity(newValue)) {
+		roomHumidity = newValue.toInt();
 		ui->humidityLabel->setText(newValue + "%");
 	}
 	if (newValue.isEmpty()) {
+		roomHumidity = 0.0;
 		ui->humidityLabel->setText("0%");
 	}
+	publishState();
+	wakeScheduler();
 }
 
 /**
@@ -531,10 +1238,52 @@ void CustomMainWindow::getHumidityEdited(const QString& newValue) {
     @param newValue -   ,   .
 **/
 void CustomMainWindow::getPressureEdited(const QString& newValue) {
+	roomPressure = toPascal(newValue.toDouble());
 	ui->pressureLabel->setText(newValue);
 	if (newValue.isEmpty()) {
 		ui->pressureLabel->setText("0");
 	}
+	publishState();
+	wakeScheduler();
+}
+
+/**
+    @brief ,       
+	   ,   
+	      .
+	     .
+**/
+void CustomMainWindow::wakeScheduler() {
+	if (startupComplete) {
+		updateScheduler->wake();
+	}
+}
+
+/**
+    @brief ,   ,   
+	 ,     , 
+	    .  
+	  ,  ,   .
+    @param temperature -    .
+    @param humidity    -   .
+    @param pressure    -   .
+**/
+void CustomMainWindow::getSensorSample(double temperature, double humidity, double pressure) {
+	double newTemperature = fromCelsius(temperature);
+	if (validateTemperature(newTemperature)) {
+		QString changedTemperature = ui->celsiusButton->isChecked() ? QString::number(qRound(newTemperature)) : QString::number(newTemperature, 'f', 2);
+		ui->temperatureLabel->setText(changedTemperature);
+		roomTemperature = temperature;
+		energyModel->setRoomTemperature(0, temperature);
+		emit temperatureChanged(changedTemperature);
+	}
+	getHumidityEdited(QString::number(qRound(humidity)));
+	roomPressure = pressure;
+	QString changedPressure = ui->mmHgButton->isChecked() ? QString::number(qRound(pressure / 133.32)) : QString::number(qRound(pressure));
+	ui->pressureLabel->setText(changedPressure);
+	emit pressureChanged(changedPressure);
+	publishState();
+	wakeScheduler();
 }
 
 /**
@@ -543,6 +1292,8 @@ void CustomMainWindow::getPressureEdited(const QString& newValue) {
 **/
 void CustomMainWindow::getInnerBlockError() {
 	ui->innerBlock->setStyleSheet(innerBlockErrorStyle);
+	indicatedFaults |= InnerBlockFault;
+	publishState();
 }
 
 /**
@@ -552,6 +1303,8 @@ void CustomMainWindow::getInnerBlockError() {
 **/
 void CustomMainWindow::getInnerBlockOk() {
 	ui->innerBlock->setStyleSheet(innerBlockOkStyle);
+	indicatedFaults &= ~InnerBlockFault;
+	publishState();
 }
 
 /**
@@ -560,6 +1313,8 @@ void CustomMainWindow::getInnerBlockOk() {
 **/
 void CustomMainWindow::getOuterBlockError() {
 	ui->outerBlock->setStyleSheet(outerBlockErrorStyle);
+	indicatedFaults |= OuterBlockFault;
+	publishState();
 }
 
 /**
@@ -569,6 +1324,8 @@ void CustomMainWindow::getOuterBlockError() {
 **/
 void CustomMainWindow::getOuterBlockOk() {
 	ui->outerBlock->setStyleSheet(outerBlockOkStyle);
+	indicatedFaults &= ~OuterBlockFault;
+	publishState();
 }
 
 /**
@@ -3,6 +3,18 @@
 #include <QtWidgets/QMainWindow>
 #include "ui_CustomMainWindow.h"
 #include "ConditionerImitation.h"
+#include "EnergyModel.h"
+#include "EnergyAnalytics.h"
+#include "StateHistory.h"
+#include "FaultRuleEngine.h"
+#include "MemoryReport.h"
+#include "StateSegment.h"
+#include "TelemetryStore.h"
+#include "UpdateScheduler.h"
+#include "SettingsStore.h"
+#include "StartupTrace.h"
+#include <QShortcut>
+#include <QElapsedTimer>
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class CustomMainWindowClass; };
@@ -21,11 +33,14 @@ class CustomMainWindow : public QMainWindow {
 	Q_OBJECT
 
 public:
-	CustomMainWindow(QWidget* parent = nullptr);
+	CustomMainWindow(QWidget* parent = nullptr, bool lowMemoryMode = false, bool viewerMode = false, const QString& settingsFile = QString());
 	~CustomMainWindow();
 
 	QString& getLightStyle();
 	QString& getDarkStyle();
+	bool isStartupComplete() const;
+	double getRoomTemperature() const;
+	QString getMemoryReport() const;
 
 signals:
 	void temperatureChanged(QString& newTemperature);
@@ -36,14 +51,29 @@ public slots:
 	void getTemperatureEdited(double newValue);
 	void getHumidityEdited(const QString& newValue);
 	void getPressureEdited(const QString& newValue);
+	void getSensorSample(double temperature, double humidity, double pressure);
 	void getInnerBlockError();
 	void getInnerBlockOk();
 	void getOuterBlockError();
 	void getOuterBlockOk();
 
 private:
-	void initializeStyles();
+	void completeStartup();
+	bool eventFilter(QObject* watched, QEvent* event) override;
+
+	QString readStyleSheet(const QString& path);
 	void initializeButtons();
+	void initializeEnergyModel();
+	void initializeStateHistory();
+	void initializeFaultRules();
+	void initializeStateSegment();
+	void initializeTelemetry();
+	void initializeScheduler();
+	void initializeIcons();
+
+	void setButtonIcon(QAbstractButton* button, const QString& path);
+	void setLabelPixmap(QLabel* label, const QString& path);
+	void setThemeIcons();
 
 	void turnOnLightMode();
 	void turnOnDarkMode();
@@ -51,6 +81,8 @@ private:
 	void switchPower();
 	void saveSettings();
 	void loadSettings();
+	bool checkGroupButton(QButtonGroup* group, const QString& name);
+	QAbstractButton* findGroupButton(QButtonGroup* group, const QString& name);
 	void setDefaultSettings();
 
 	void increaseTemperature();
@@ -61,6 +93,7 @@ private:
 	void changeTemperatureModeFromKelvin();
 
 	bool validateHumidity(const QString& newValue);
+	bool validatePressure(double newValue);
 
 	void changePressureModeFromMmHg();
 	void changePressureModeFromPascal();
@@ -69,6 +102,28 @@ private:
 	void changeDirectionToCenter();
 	void changeDirectionToRight();
 
+	double toCelsius(double value);
+	double fromCelsius(double value);
+	double toPascal(double value);
+	void updateSetpoint();
+	void updateDirection();
+	void updateEnergy();
+	void updateEnergyToolTip();
+
+	ControllerState captureState();
+	void recordState();
+	void applyState(const ControllerState& state);
+	void undoChange();
+	void redoChange();
+
+	bool evaluateFaultRules();
+	void wakeScheduler();
+
+	void checkMemoryBudget();
+
+	void publishState();
+	bool pollState();
+
 	void closeEvent(QCloseEvent* event) override;
 
 	void resizeEvent(QResizeEvent* event) override;
@@ -85,6 +140,45 @@ private:
 
 	QSize resizeBuffer;
 
+	EnergyModel* energyModel = nullptr;
+	EnergyAnalytics* energyAnalytics = nullptr;
+	QElapsedTimer energyClock;
+
+	StateHistory* stateHistory = nullptr;
+	QShortcut* undoShortcut = nullptr;
+	QShortcut* redoShortcut = nullptr;
+	bool restoringState = false;
+
+	FaultRuleEngine* faultRuleEngine = nullptr;
+	QElapsedTimer faultClock;
+	quint8 detectedFaults = 0;
+	double roomTemperature = 0.0;
+	double roomHumidity = 0.0;
+	double roomPressure = 0.0;
+
+	TelemetryStore* telemetryStore = nullptr;
+
+	QString settingsFile;
+	SettingsStore* settingsStore;
+
+	UpdateScheduler* updateScheduler = nullptr;
+	ChangeDetector temperatureChange;
+	ChangeDetector humidityChange;
+	ChangeDetector pressureChange;
+	ChangeDetector powerChange;
+
+	bool lowMemoryMode;
+	MemoryReport memoryReport;
+
+	bool viewerMode;
+	StateSegment* stateSegment = nullptr;
+	quint32 stateSequence = 0;
+	quint8 indicatedFaults = 0;
+
+	StartupTrace startupTrace;
+	bool startupComplete = false;
+	bool settingsWarning = false;
+
 	Ui::CustomMainWindowClass* ui;
 	ConditionerImitation* subWindow;
 };
@@ -0,0 +1,230 @@
+#include "EnergyAnalytics.h"
+#include "AppData.h"
+#include <algorithm>
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ENERGY_ANALYTICS_SSE2
+#endif
+
+namespace {
+
+/**
+    @brief ,       .
+    @param totals -    .
+    @param row    -  ,     .
+    @param count  -  .
+**/
+void addRow(float* totals, const float* row, int count) {
+	int i = 0;
+#ifdef ENERGY_ANALYTICS_SSE2
+	for (; i + 8 <= count; i += 8) {
+		__m128 first = _mm_add_ps(_mm_loadu_ps(totals + i), _mm_loadu_ps(row + i));
+		__m128 second = _mm_add_ps(_mm_loadu_ps(totals + i + 4), _mm_loadu_ps(row + i + 4));
+		_mm_storeu_ps(totals + i, first);
+		_mm_storeu_ps(totals + i + 4, second);
+	}
+#endif
+	for (; i < count; i++) {
+		totals[i] += row[i];
+	}
+}
+
+}
+
+/**
+    @brief    .
+    @param unitCount    -   .
+    @param capacityDays -     .
+**/
+EnergyAnalytics::EnergyAnalytics(int unitCount, int capacityDays)
+	: unitCount(unitCount), capacityHours(capacityDays * 24), firstHour(-1), lastHour(-1),
+	hourly(capacityDays * 24 * unitCount, 0.0f) {
+}
+
+/**
+    @brief  ,    .
+    @retval  -  .
+**/
+int EnergyAnalytics::getUnitCount() const {
+	return unitCount;
+}
+
+/**
+    @brief  ,     ,   .
+    @retval  -      UTC  -1,   .
+**/
+qint64 EnergyAnalytics::getFirstDay() const {
+	return firstHour < 0 ? -1 : firstHour / 24;
+}
+
+/**
+    @brief  ,    ,   .
+    @retval  -      UTC  -1,   .
+**/
+qint64 EnergyAnalytics::getLastDay() const {
+	return lastHour < 0 ? -1 : lastHour / 24;
+}
+
+/**
+    @brief ,    ,  .
+	        
+	,  ,    , .
+    @param epochSeconds -        UTC.
+    @param consumed     -     * 
+	getUnitCount().
+**/
+void EnergyAnalytics::accumulate(qint64 epochSeconds, const float* consumed) {
+	qint64 hour = epochSeconds / 3600;
+	if (lastHour < 0) {
+		firstHour = hour;
+		lastHour = hour;
+		std::fill_n(rowAt(hour), unitCount, 0.0f);
+	}
+	else if (hour > lastHour) {
+		qint64 newRows = std::min<qint64>(hour - lastHour, capacityHours);
+		for (qint64 h = hour - newRows + 1; h <= hour; h++) {
+			std::fill_n(rowAt(h), unitCount, 0.0f);
+		}
+		lastHour = hour;
+		firstHour = std::max(firstHour, lastHour - capacityHours + 1);
+	}
+	else if (hour < firstHour) {
+		return;
+	}
+	addRow(rowAt(hour), consumed, unitCount);
+}
+
+/**
+    @brief ,      .
+    @param day    -      UTC.
+    @param totals - ,      *  .
+**/
+void EnergyAnalytics::computeDailyTotals(qint64 day, QVector<float>& totals) const {
+	totals.fill(0.0f, unitCount);
+	addHours(day * 24, day * 24 + 23, totals.data());
+}
+
+/**
+    @brief ,       ,
+	 .
+    @param lastDay -        UTC.
+    @param totals  - ,      *  .
+**/
+void EnergyAnalytics::computeWeeklyTotals(qint64 lastDay, QVector<float>& totals) const {
+	totals.fill(0.0f, unitCount);
+	addHours((lastDay - 6) * 24, lastDay * 24 + 23, totals.data());
+}
+
+/**
+    @brief ,      
+	(  )    .
+	     .   
+	 ,     .
+    @param forecast    - ,      *  .
+    @param horizonDays -  ,    ,
+	   1.
+**/
+void EnergyAnalytics::computeDailyForecast(QVector<float>& forecast, int horizonDays) const {
+	forecast.fill(0.0f, unitCount);
+	if (lastHour < 0) {
+		return;
+	}
+	float* forecastData = forecast.data();
+	qint64 fromDay = firstHour % 24 == 0 ? firstHour / 24 : firstHour / 24 + 1;
+	qint64 toDay = lastHour / 24 - 1;
+	if (fromDay > toDay) {
+		addHours(firstHour, lastHour, forecastData);
+		float scale = float(24 * horizonDays) / float(lastHour - firstHour + 1);
+		for (int i = 0; i < unitCount; i++) {
+			forecastData[i] *= scale;
+		}
+		return;
+	}
+	QVector<float> level;
+	QVector<float> trend(unitCount, 0.0f);
+	QVector<float> observed;
+	computeDailyTotals(fromDay, level);
+	float* levelData = level.data();
+	float* trendData = trend.data();
+	const float alpha = float(FORECAST_LEVEL_SMOOTHING);
+	const float beta = float(FORECAST_TREND_SMOOTHING);
+	for (qint64 day = fromDay + 1; day <= toDay; day++) {
+		computeDailyTotals(day, observed);
+		const float* observedData = observed.constData();
+		for (int i = 0; i < unitCount; i++) {
+			float newLevel = alpha * observedData[i] + (1.0f - alpha) * (levelData[i] + trendData[i]);
+			trendData[i] = beta * (newLevel - levelData[i]) + (1.0f - beta) * trendData[i];
+			levelData[i] = newLevel;
+		}
+	}
+	const float horizon = float(horizonDays);
+	const float trendWeight = horizon * (horizon + 1.0f) / 2.0f;
+	for (int i = 0; i < unitCount; i++) {
+		forecastData[i] = std::max(0.0f, horizon * levelData[i] + trendWeight * trendData[i]);
+	}
+}
+
+/**
+    @brief  ,     .
+    @param  totals -    .
+    @retval        -    *.
+**/
+double EnergyAnalytics::sumTotals(const QVector<float>& totals) {
+	const float* data = totals.constData();
+	const int count = totals.size();
+	int i = 0;
+	double sum = 0.0;
+#ifdef ENERGY_ANALYTICS_SSE2
+	__m128d first = _mm_setzero_pd();
+	__m128d second = _mm_setzero_pd();
+	for (; i + 4 <= count; i += 4) {
+		__m128 values = _mm_loadu_ps(data + i);
+		first = _mm_add_pd(first, _mm_cvtps_pd(values));
+		second = _mm_add_pd(second, _mm_cvtps_pd(_mm_movehl_ps(values, values)));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(first, second));
+	sum = lanes[0] + lanes[1];
+#endif
+	for (; i < count; i++) {
+		sum += data[i];
+	}
+	return sum;
+}
+
+/**
+    @brief ,       
+	 . ,   , .
+    @param fromHour -       UTC.
+    @param toHour   -       UTC.
+    @param totals   -    .
+**/
+void EnergyAnalytics::addHours(qint64 fromHour, qint64 toHour, float* totals) const {
+	if (lastHour < 0) {
+		return;
+	}
+	fromHour = std::max(fromHour, firstHour);
+	toHour = std::min(toHour, lastHour);
+	for (qint64 hour = fromHour; hour <= toHour; hour++) {
+		addRow(totals, rowAt(hour), unitCount);
+	}
+}
+
+/**
+    @brief  ,       .
+    @param  hour -     UTC.
+    @retval      -       .
+**/
+const float* EnergyAnalytics::rowAt(qint64 hour) const {
+	return hourly.constData() + (hour % capacityHours) * unitCount;
+}
+
+/**
+    @brief  ,     
+	  .
+    @param  hour -     UTC.
+    @retval      -       .
+**/
+float* EnergyAnalytics::rowAt(qint64 hour) {
+	return hourly.data() + (hour % capacityHours) * unitCount;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <QVector>
+
+/**
+
+	@class   EnergyAnalytics
+	@brief   ,     
+	         
+	,    .    
+	,         
+	,      .
+
+**/
+class EnergyAnalytics {
+public:
+	EnergyAnalytics(int unitCount, int capacityDays);
+
+	int getUnitCount() const;
+	qint64 getFirstDay() const;
+	qint64 getLastDay() const;
+
+	void accumulate(qint64 epochSeconds, const float* consumed);
+
+	void computeDailyTotals(qint64 day, QVector<float>& totals) const;
+	void computeWeeklyTotals(qint64 lastDay, QVector<float>& totals) const;
+	void computeDailyForecast(QVector<float>& forecast, int horizonDays = 1) const;
+
+	static double sumTotals(const QVector<float>& totals);
+
+private:
+	void addHours(qint64 fromHour, qint64 toHour, float* totals) const;
+	const float* rowAt(qint64 hour) const;
+	float* rowAt(qint64 hour);
+
+	int unitCount;
+	int capacityHours;
+	qint64 firstHour;
+	qint64 lastHour;
+	QVector<float> hourly;
+};
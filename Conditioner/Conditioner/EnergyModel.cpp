@@ -0,0 +1,133 @@
+#include "EnergyModel.h"
+#include "AppData.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+    @brief   .
+    @param unitCount -    ,
+	   1.    .
+**/
+EnergyModel::EnergyModel(int unitCount)
+	: unitCount(unitCount), setpoint(unitCount, 0.0), room(unitCount, 0.0), directionFactor(unitCount, 1.0),
+	powerMask(unitCount, 0.0), load(unitCount, 0.0), powerDraw(unitCount, 0.0), energy(unitCount, 0.0) {
+}
+
+/**
+    @brief  ,    .
+    @retval  -   .
+**/
+int EnergyModel::getUnitCount() const {
+	return unitCount;
+}
+
+/**
+    @brief ,    .
+    @param unit    -  .
+    @param celsius -     .
+**/
+void EnergyModel::setSetpoint(int unit, double celsius) {
+	setpoint[unit] = celsius;
+}
+
+/**
+    @brief ,     ,
+	 .
+    @param unit    -  .
+    @param celsius -      .
+**/
+void EnergyModel::setRoomTemperature(int unit, double celsius) {
+	room[unit] = celsius;
+}
+
+/**
+    @brief ,    . 
+	      .
+    @param unit      -  .
+    @param direction -   .
+**/
+void EnergyModel::setDirection(int unit, AirDirection direction) {
+	directionFactor[unit] = direction == AirDirection::Center ? 1.0 : DEFLECTED_AIRFLOW_FACTOR;
+}
+
+/**
+    @brief ,    .
+    @param unit -  .
+    @param on   - true,   ,  false.
+**/
+void EnergyModel::setPower(int unit, bool on) {
+	powerMask[unit] = on ? 1.0 : 0.0;
+	if (!on) {
+		load[unit] = 0.0;
+		powerDraw[unit] = 0.0;
+	}
+}
+
+/**
+    @brief ,     ,
+	,    .
+    @param unit -  .
+    @param kWh  -    *.
+**/
+void EnergyModel::setConsumedEnergy(int unit, double kWh) {
+	energy[unit] = kWh;
+}
+
+/**
+    @brief  ,   ,  
+	  .
+    @param  unit -  .
+    @retval      -        [0; 1].
+**/
+double EnergyModel::getLoad(int unit) const {
+	return load[unit];
+}
+
+/**
+    @brief  ,  ,  .
+    @param  unit -  .
+    @retval      -    .
+**/
+double EnergyModel::getPowerDraw(int unit) const {
+	return powerDraw[unit];
+}
+
+/**
+    @brief  ,     .
+    @param  unit -  .
+    @retval      -    *.
+**/
+double EnergyModel::getConsumedEnergy(int unit) const {
+	return energy[unit];
+}
+
+/**
+    @brief ,       .
+	   ,    .
+    @param seconds  -    .
+    @param consumed -    getUnitCount(),  
+	   *,      .
+**/
+void EnergyModel::step(double seconds, float* consumed) {
+	const double hours = seconds / 3600.0;
+	const double* setpointData = setpoint.constData();
+	const double* roomData = room.constData();
+	const double* directionData = directionFactor.constData();
+	const double* maskData = powerMask.constData();
+	double* loadData = load.data();
+	double* drawData = powerDraw.data();
+	double* energyData = energy.data();
+	for (int i = 0; i < unitCount; i++) {
+		double delta = std::fabs(roomData[i] - setpointData[i]);
+		double unitLoad = std::min(1.0, std::max(MIN_COMPRESSOR_LOAD, delta / FULL_LOAD_DELTA)) * maskData[i];
+		double draw = (FAN_POWER + COMPRESSOR_RATED_POWER * unitLoad) * directionData[i] * maskData[i];
+		loadData[i] = unitLoad;
+		drawData[i] = draw;
+		energyData[i] += draw * hours;
+	}
+	if (consumed != nullptr) {
+		for (int i = 0; i < unitCount; i++) {
+			consumed[i] = float(drawData[i] * hours);
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <QVector>
+
+/**
+	@enum    AirDirection
+	@brief      .
+**/
+enum class AirDirection {
+	Left,
+	Center,
+	Right
+};
+
+/**
+
+	@class   EnergyModel
+	@brief   ,    
+	.    
+	      ,  
+	 .      
+	,       .
+
+**/
+class EnergyModel {
+public:
+	EnergyModel(int unitCount = 1);
+
+	int getUnitCount() const;
+
+	void setSetpoint(int unit, double celsius);
+	void setRoomTemperature(int unit, double celsius);
+	void setDirection(int unit, AirDirection direction);
+	void setPower(int unit, bool on);
+	void setConsumedEnergy(int unit, double kWh);
+
+	double getLoad(int unit) const;
+	double getPowerDraw(int unit) const;
+	double getConsumedEnergy(int unit) const;
+
+	void step(double seconds, float* consumed = nullptr);
+
+private:
+	int unitCount;
+
+	QVector<double> setpoint;
+	QVector<double> room;
+	QVector<double> directionFactor;
+	QVector<double> powerMask;
+	QVector<double> load;
+	QVector<double> powerDraw;
+	QVector<double> energy;
+};
@@ -0,0 +1,125 @@
+#include "FaultRuleEngine.h"
+#include <cmath>
+
+/**
+    @brief      .
+    @param unitCount -   ,    1.
+**/
+FaultRuleEngine::FaultRuleEngine(int unitCount)
+	: unitCount(unitCount), primed(false), previousValues(unitCount * CHANNEL_COUNT, 0.0f) {
+}
+
+/**
+    @brief ,     . 
+	   .
+    @param rules -  .
+**/
+void FaultRuleEngine::setRules(const QVector<FaultRule>& rules) {
+	const int ruleCount = rules.size();
+	inputIndex.resize(ruleCount);
+	sign.resize(ruleCount);
+	signedLimit.resize(ruleCount);
+	duration.resize(ruleCount);
+	blockMask.resize(ruleCount);
+	for (int r = 0; r < ruleCount; r++) {
+		const FaultRule& rule = rules.at(r);
+		float ruleSign = rule.comparison == FaultComparison::Above ? 1.0f : -1.0f;
+		inputIndex[r] = int(rule.channel) + (rule.kind == FaultRuleKind::RateOfChange ? CHANNEL_COUNT : 0);
+		sign[r] = ruleSign;
+		signedLimit[r] = ruleSign * rule.limit;
+		duration[r] = rule.kind == FaultRuleKind::Duration ? rule.duration : 0.0f;
+		blockMask[r] = rule.block;
+	}
+	heldTime.fill(0.0f, unitCount * ruleCount);
+}
+
+/**
+    @brief  ,    .
+    @retval  -  .
+**/
+int FaultRuleEngine::getRuleCount() const {
+	return inputIndex.size();
+}
+
+/**
+    @brief  ,    .
+    @retval  -  .
+**/
+int FaultRuleEngine::getUnitCount() const {
+	return unitCount;
+}
+
+/**
+    @brief ,        
+	 .     
+	,      .
+    @param temperature -      .
+    @param humidity    -      .
+    @param pressure    -      .
+    @param seconds     - ,    ,  .
+    @param faults      - ,     FaultBlock
+	 .
+**/
+void FaultRuleEngine::evaluate(const float* temperature, const float* humidity, const float* pressure, float seconds, quint8* faults) {
+	const int ruleCount = inputIndex.size();
+	const float rateScale = primed && seconds > 0.0f ? 1.0f / seconds : 0.0f;
+	const int* indexData = inputIndex.constData();
+	const float* signData = sign.constData();
+	const float* limitData = signedLimit.constData();
+	const float* durationData = duration.constData();
+	const quint8* maskData = blockMask.constData();
+	for (int u = 0; u < unitCount; u++) {
+		float inputs[INPUT_COUNT];
+		float* previous = previousValues.data() + u * CHANNEL_COUNT;
+		inputs[0] = temperature[u];
+		inputs[1] = humidity[u];
+		inputs[2] = pressure[u];
+		for (int c = 0; c < CHANNEL_COUNT; c++) {
+			inputs[CHANNEL_COUNT + c] = std::fabs(inputs[c] - previous[c]) * rateScale;
+			previous[c] = inputs[c];
+		}
+		float* held = heldTime.data() + qint64(u) * ruleCount;
+		quint8 unitFaults = 0;
+		for (int r = 0; r < ruleCount; r++) {
+			int active = int(inputs[indexData[r]] * signData[r] > limitData[r]);
+			float time = (held[r] + seconds) * float(active);
+			held[r] = time;
+			unitFaults |= quint8(-(active & int(time >= durationData[r]))) & maskData[r];
+		}
+		faults[u] = unitFaults;
+	}
+	primed = true;
+}
+
+/**
+    @brief ,      
+	 ,       
+	    .
+**/
+void FaultRuleEngine::reset() {
+	primed = false;
+	previousValues.fill(0.0f);
+	heldTime.fill(0.0f);
+}
+
+/**
+    @brief  ,        .
+    @retval  -  .
+**/
+QVector<FaultRule> FaultRuleEngine::getDefaultRules() {
+	return {
+		//    .
+		{ FaultChannel::Temperature, FaultRuleKind::Duration, FaultComparison::Below, 5.0f, 60.0f, InnerBlockFault },
+		//  :     90%.
+		{ FaultChannel::Humidity, FaultRuleKind::Duration, FaultComparison::Above, 90.0f, 300.0f, InnerBlockFault },
+		//    .
+		{ FaultChannel::Temperature, FaultRuleKind::RateOfChange, FaultComparison::Above, 5.0f, 0.0f, InnerBlockFault },
+		//    .
+		{ FaultChannel::Temperature, FaultRuleKind::Duration, FaultComparison::Above, 40.0f, 120.0f, OuterBlockFault },
+		//    .
+		{ FaultChannel::Pressure, FaultRuleKind::Threshold, FaultComparison::Below, 80000.0f, 0.0f, OuterBlockFault },
+		{ FaultChannel::Pressure, FaultRuleKind::Threshold, FaultComparison::Above, 110000.0f, 0.0f, OuterBlockFault },
+		//    .
+		{ FaultChannel::Pressure, FaultRuleKind::RateOfChange, FaultComparison::Above, 1000.0f, 0.0f, OuterBlockFault }
+	};
+}
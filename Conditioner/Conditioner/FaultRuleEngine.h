@@ -0,0 +1,96 @@
+#pragma once
+#include <QVector>
+
+/**
+	@enum    FaultChannel
+	@brief    ,    .
+**/
+enum class FaultChannel {
+	Temperature,
+	Humidity,
+	Pressure
+};
+
+/**
+	@enum    FaultRuleKind
+	@brief    :  ,   
+	  ,   .
+**/
+enum class FaultRuleKind {
+	Threshold,
+	RateOfChange,
+	Duration
+};
+
+/**
+	@enum    FaultComparison
+	@brief       .
+**/
+enum class FaultComparison {
+	Above,
+	Below
+};
+
+/**
+	@enum    FaultBlock
+	@brief     ,    .
+**/
+enum FaultBlock : quint8 {
+	InnerBlockFault = 1,
+	OuterBlockFault = 2
+};
+
+/**
+	@struct  FaultRule
+	@brief     .    
+	,   ,   ,   - 
+	   ,  -  .
+**/
+struct FaultRule {
+	FaultChannel channel;
+	FaultRuleKind kind;
+	FaultComparison comparison;
+	float limit;
+	float duration;
+	quint8 block;
+};
+
+/**
+
+	@class   FaultRuleEngine
+	@brief   ,      
+	,      .
+	       ,
+	          
+	 ,      .
+
+**/
+class FaultRuleEngine {
+public:
+	FaultRuleEngine(int unitCount = 1);
+
+	void setRules(const QVector<FaultRule>& rules);
+	int getRuleCount() const;
+	int getUnitCount() const;
+
+	void evaluate(const float* temperature, const float* humidity, const float* pressure, float seconds, quint8* faults);
+	void reset();
+
+	static QVector<FaultRule> getDefaultRules();
+
+private:
+	static const int CHANNEL_COUNT = 3;
+	static const int INPUT_COUNT = CHANNEL_COUNT * 2;
+
+	int unitCount;
+	bool primed;
+
+	QVector<int> inputIndex;
+	QVector<float> sign;
+	QVector<float> signedLimit;
+	QVector<float> duration;
+	QVector<quint8> blockMask;
+
+	QVector<float> previousValues;
+	QVector<float> heldTime;
+};
@@ -0,0 +1,74 @@
+#include "IconCache.h"
+#include <QImage>
+#include <QtMath>
+
+QHash<QString, QPixmap> IconCache::pixmaps;
+
+/**
+    @brief  ,  ,    
+	  .      ,
+	   QLabel   scaledContents.   
+	     ,  
+	    .
+    @param  path  -    .
+    @param  size  -      .
+    @param  ratio -    .
+    @retval       -    ,    .
+**/
+QPixmap IconCache::getPixmap(const QString& path, const QSize& size, qreal ratio) {
+	QString key = QString("%1@%2x%3@%4").arg(path).arg(size.width()).arg(size.height()).arg(ratio);
+	QHash<QString, QPixmap>::const_iterator it = pixmaps.constFind(key);
+	if (it != pixmaps.constEnd()) {
+		return it.value();
+	}
+	QImage image(path);
+	if (image.isNull()) {
+		return QPixmap();
+	}
+	QSize deviceSize(qCeil(size.width() * ratio), qCeil(size.height() * ratio));
+	QPixmap pixmap = QPixmap::fromImage(image.scaled(deviceSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+	pixmap.setDevicePixelRatio(ratio);
+	pixmaps.insert(key, pixmap);
+	return pixmap;
+}
+
+/**
+    @brief  ,   ,   
+	,       .
+    @param  path  -    .
+    @param  size  -      .
+    @param  ratio -    .
+    @retval       - .
+**/
+QIcon IconCache::getIcon(const QString& path, const QSize& size, qreal ratio) {
+	return QIcon(getPixmap(path, size, ratio));
+}
+
+/**
+    @brief  ,      .
+    @retval  -  .
+**/
+int IconCache::getCount() {
+	return pixmaps.size();
+}
+
+/**
+    @brief  ,   ,  
+	 .
+    @retval  -   .
+**/
+qint64 IconCache::getBytes() {
+	qint64 bytes = 0;
+	for (const QPixmap& pixmap : pixmaps) {
+		bytes += qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+	}
+	return bytes;
+}
+
+/**
+    @brief ,  . ,    
+	,     .
+**/
+void IconCache::clear() {
+	pixmaps.clear();
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <QHash>
+#include <QIcon>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+
+/**
+
+	@class   IconCache
+	@brief    ,      
+	     .   
+	 :     , 
+	Qt    ,     
+	 . QPixmap  ,   , 
+	    ,      .
+
+**/
+class IconCache {
+public:
+	static QPixmap getPixmap(const QString& path, const QSize& size, qreal ratio);
+	static QIcon getIcon(const QString& path, const QSize& size, qreal ratio);
+
+	static int getCount();
+	static qint64 getBytes();
+	static void clear();
+
+private:
+	static QHash<QString, QPixmap> pixmaps;
+};
@@ -0,0 +1,102 @@
+#include "MemoryReport.h"
+#include <QtGlobal>
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <QFile>
+#include <unistd.h>
+#endif
+
+/**
+    @brief     .  
+	    .
+**/
+MemoryReport::MemoryReport() {
+	start();
+}
+
+/**
+    @brief ,       .
+**/
+void MemoryReport::start() {
+	baseline = getResidentBytes();
+	lastMark = baseline;
+	usage.clear();
+}
+
+/**
+    @brief ,       
+	     .
+    @param subsystem -  .
+**/
+void MemoryReport::record(const QString& subsystem) {
+	qint64 current = getResidentBytes();
+	qint64 delta = current - lastMark;
+	lastMark = current;
+	for (MemoryUsage& entry : usage) {
+		if (entry.subsystem == subsystem) {
+			entry.bytes += delta;
+			return;
+		}
+	}
+	usage.append({ subsystem, delta });
+}
+
+/**
+    @brief  ,  ,   ,  
+	  .
+    @retval  -  .
+**/
+const QVector<MemoryUsage>& MemoryReport::getUsage() const {
+	return usage;
+}
+
+/**
+    @brief  ,      
+	 .
+    @retval  -   .
+**/
+qint64 MemoryReport::getBaseline() const {
+	return baseline;
+}
+
+/**
+    @brief  ,   :  , 
+	        .
+    @retval  - ,     .
+**/
+QString MemoryReport::format() const {
+	QString report = QString("baseline: %1 KiB\n").arg(baseline / 1024);
+	for (const MemoryUsage& entry : usage) {
+		report += QString("%1: %2 KiB\n").arg(entry.subsystem).arg(entry.bytes / 1024);
+	}
+	report += QString("resident: %1 KiB").arg(getResidentBytes() / 1024);
+	return report;
+}
+
+/**
+    @brief  ,      .
+    @retval  -     0,    .
+**/
+qint64 MemoryReport::getResidentBytes() {
+#if defined(Q_OS_WIN)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return qint64(counters.WorkingSetSize);
+	}
+	return 0;
+#elif defined(Q_OS_LINUX)
+	QFile statm("/proc/self/statm");
+	if (!statm.open(QFile::ReadOnly)) {
+		return 0;
+	}
+	QList<QByteArray> fields = statm.readAll().split(' ');
+	if (fields.size() < 2) {
+		return 0;
+	}
+	return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <QString>
+#include <QVector>
+
+/**
+	@struct  MemoryUsage
+	@brief     ,    .
+**/
+struct MemoryUsage {
+	QString subsystem;
+	qint64 bytes;
+};
+
+/**
+
+	@class   MemoryReport
+	@brief   ,     (RSS) 
+	 .  RSS     
+	,    ;   
+	 ,       
+	 .
+
+**/
+class MemoryReport {
+public:
+	MemoryReport();
+
+	void start();
+	void record(const QString& subsystem);
+
+	const QVector<MemoryUsage>& getUsage() const;
+	qint64 getBaseline() const;
+	QString format() const;
+
+	static qint64 getResidentBytes();
+
+private:
+	qint64 baseline;
+	qint64 lastMark;
+	QVector<MemoryUsage> usage;
+};
@@ -0,0 +1,130 @@
+#pragma once
+#include <QSharedPointer>
+#include <QVector>
+
+/**
+
+	@class   PersistentVector
+	@brief       .  
+	  32- ,     
+	   ,     
+	        (  log32(n) ).
+	        .
+
+**/
+template <typename T>
+class PersistentVector {
+public:
+	PersistentVector() : count(0), shift(0) {
+	}
+
+	/**
+	    @brief  ,    .
+	    @retval  -  .
+	**/
+	int size() const {
+		return count;
+	}
+
+	/**
+	    @brief  ,     .
+	    @param  index -  .
+	    @retval       -   .
+	**/
+	const T& at(int index) const {
+		const Node* node = root.data();
+		for (int level = shift; level > 0; level -= BITS) {
+			node = node->children.at((index >> level) & MASK).data();
+		}
+		return node->values.at(index & MASK);
+	}
+
+	/**
+	    @brief  ,      .
+	    @param  index -  .
+	    @param  value -   .
+	    @retval       -   ,    .
+	**/
+	PersistentVector set(int index, const T& value) const {
+		PersistentVector result(*this);
+		result.root = assign(root, shift, index, value);
+		return result;
+	}
+
+	/**
+	    @brief  ,     ,   .
+	    @param  value -  .
+	    @retval       -   ,    .
+	**/
+	PersistentVector append(const T& value) const {
+		PersistentVector result(*this);
+		if (root.isNull()) {
+			result.root = createPath(0, value);
+		}
+		else if (count == 1 << (shift + BITS)) {
+			QSharedPointer<Node> newRoot(new Node());
+			newRoot->children.append(root);
+			newRoot->children.append(createPath(shift, value));
+			result.root = newRoot;
+			result.shift = shift + BITS;
+		}
+		else {
+			result.root = pushBack(root, shift, count, value);
+		}
+		result.count = count + 1;
+		return result;
+	}
+
+private:
+	struct Node {
+		QVector<QSharedPointer<const Node>> children;
+		QVector<T> values;
+	};
+
+	static const int BITS = 5;
+	static const int MASK = (1 << BITS) - 1;
+
+	static QSharedPointer<const Node> assign(const QSharedPointer<const Node>& node, int level, int index, const T& value) {
+		QSharedPointer<Node> copy(new Node(*node));
+		if (level == 0) {
+			copy->values[index & MASK] = value;
+		}
+		else {
+			int child = (index >> level) & MASK;
+			copy->children[child] = assign(node->children.at(child), level - BITS, index, value);
+		}
+		return copy;
+	}
+
+	static QSharedPointer<const Node> createPath(int level, const T& value) {
+		QSharedPointer<Node> node(new Node());
+		if (level == 0) {
+			node->values.append(value);
+		}
+		else {
+			node->children.append(createPath(level - BITS, value));
+		}
+		return node;
+	}
+
+	static QSharedPointer<const Node> pushBack(const QSharedPointer<const Node>& node, int level, int index, const T& value) {
+		QSharedPointer<Node> copy(new Node(*node));
+		if (level == 0) {
+			copy->values.append(value);
+		}
+		else {
+			int child = (index >> level) & MASK;
+			if (child < copy->children.size()) {
+				copy->children[child] = pushBack(node->children.at(child), level - BITS, index, value);
+			}
+			else {
+				copy->children.append(createPath(level - BITS, value));
+			}
+		}
+		return copy;
+	}
+
+	QSharedPointer<const Node> root;
+	int count;
+	int shift;
+};
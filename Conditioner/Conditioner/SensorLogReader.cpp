@@ -0,0 +1,347 @@
+#include "SensorLogReader.h"
+#include <QByteArray>
+#include <cstring>
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SENSOR_LOG_SSE2
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+const double powersOfTen[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+    @brief  ,      .
+    @param  mask -   .
+    @retval      -    .
+**/
+inline int lowestBit(unsigned mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return int(index);
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+/**
+    @brief  ,      .
+	    16 .
+    @param  p   -  .
+    @param  end -  .
+    @retval     -    ','  '\n'  end,   .
+**/
+const char* findDelimiter(const char* p, const char* end) {
+#ifdef SENSOR_LOG_SSE2
+	const __m128i comma = _mm_set1_epi8(',');
+	const __m128i newline = _mm_set1_epi8('\n');
+	while (end - p >= 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		unsigned mask = unsigned(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, comma), _mm_cmpeq_epi8(chunk, newline))));
+		if (mask != 0) {
+			return p + lowestBit(mask);
+		}
+		p += 16;
+	}
+#endif
+	while (p < end && *p != ',' && *p != '\n') {
+		p++;
+	}
+	return p;
+}
+
+/**
+    @brief  ,      . 
+	   2^53    22    
+	 ,     Qt.
+    @param  p        -  .
+    @param  fieldEnd -  .
+    @param  value    - ,    .
+    @retval          -  true,     ,
+	  false.
+**/
+bool parseNumber(const char* p, const char* fieldEnd, double& value) {
+	while (p < fieldEnd && (*p == ' ' || *p == '\t')) {
+		p++;
+	}
+	while (fieldEnd > p && (fieldEnd[-1] == ' ' || fieldEnd[-1] == '\t' || fieldEnd[-1] == '\r')) {
+		fieldEnd--;
+	}
+	const char* fieldBegin = p;
+	bool negative = false;
+	if (p < fieldEnd && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		p++;
+	}
+	quint64 mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	bool hasDigits = false;
+	bool truncated = false;
+	while (p < fieldEnd && unsigned(*p - '0') < 10) {
+		if (digits < 19) {
+			mantissa = mantissa * 10 + unsigned(*p - '0');
+			digits += mantissa != 0;
+		}
+		else {
+			exponent++;
+			truncated = true;
+		}
+		hasDigits = true;
+		p++;
+	}
+	if (p < fieldEnd && *p == '.') {
+		p++;
+		while (p < fieldEnd && unsigned(*p - '0') < 10) {
+			if (digits < 19) {
+				mantissa = mantissa * 10 + unsigned(*p - '0');
+				digits += mantissa != 0;
+				exponent--;
+			}
+			else {
+				truncated = true;
+			}
+			hasDigits = true;
+			p++;
+		}
+	}
+	if (!hasDigits) {
+		return false;
+	}
+	if (p < fieldEnd && (*p == 'e' || *p == 'E')) {
+		p++;
+		int exponentSign = 1;
+		if (p < fieldEnd && (*p == '-' || *p == '+')) {
+			exponentSign = *p == '-' ? -1 : 1;
+			p++;
+		}
+		if (p == fieldEnd) {
+			return false;
+		}
+		int explicitExponent = 0;
+		while (p < fieldEnd && unsigned(*p - '0') < 10) {
+			explicitExponent = qMin(explicitExponent * 10 + (*p - '0'), 9999);
+			p++;
+		}
+		exponent += exponentSign * explicitExponent;
+	}
+	if (p != fieldEnd) {
+		return false;
+	}
+	if (!truncated && mantissa <= (quint64(1) << 53) && exponent >= -22 && exponent <= 22) {
+		double result = exponent < 0 ? double(mantissa) / powersOfTen[-exponent] : double(mantissa) * powersOfTen[exponent];
+		value = negative ? -result : result;
+		return true;
+	}
+	bool ok = false;
+	value = QByteArray::fromRawData(fieldBegin, int(fieldEnd - fieldBegin)).toDouble(&ok);
+	return ok;
+}
+
+}
+
+/**
+    @brief      .
+    @param path -    .
+**/
+SensorLogReader::SensorLogReader(const QString& path)
+	: file(path), begin(nullptr), cursor(nullptr), end(nullptr), rowCount(0), errorCount(0),
+	windowSum{ 0.0, 0.0, 0.0, 0.0 }, windowStart(0.0), windowCount(0) {
+}
+
+/**
+    @brief      .
+**/
+SensorLogReader::~SensorLogReader() {
+	close();
+}
+
+/**
+    @brief  ,        .
+	 ,   , .
+    @retval  -  true,    ,   false.
+**/
+bool SensorLogReader::open() {
+	close();
+	if (!file.open(QFile::ReadOnly) || file.size() == 0) {
+		file.close();
+		return false;
+	}
+	uchar* data = file.map(0, file.size());
+	if (data == nullptr) {
+		file.close();
+		return false;
+	}
+	begin = reinterpret_cast<const char*>(data);
+	cursor = begin;
+	end = begin + file.size();
+	rowCount = 0;
+	errorCount = 0;
+	windowCount = 0;
+	if (*cursor != '-' && *cursor != '+' && *cursor != '.' && unsigned(*cursor - '0') >= 10) {
+		skipLine(cursor);
+	}
+	return true;
+}
+
+/**
+    @brief ,   .
+**/
+void SensorLogReader::close() {
+	if (begin != nullptr) {
+		file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(begin)));
+		begin = nullptr;
+		cursor = nullptr;
+		end = nullptr;
+	}
+	if (file.isOpen()) {
+		file.close();
+	}
+}
+
+/**
+    @brief  , ,    .
+    @retval  -  true,   ,   false.
+**/
+bool SensorLogReader::isOpen() const {
+	return begin != nullptr;
+}
+
+/**
+    @brief  , ,    .
+    @retval  -  true,       
+	  ,   false.
+**/
+bool SensorLogReader::atEnd() const {
+	return cursor == end && windowCount == 0;
+}
+
+/**
+    @brief  ,    .
+    @retval  -    .
+**/
+qint64 SensorLogReader::getSize() const {
+	return end - begin;
+}
+
+/**
+    @brief  ,     .
+    @retval  -  .
+**/
+qint64 SensorLogReader::getRowCount() const {
+	return rowCount;
+}
+
+/**
+    @brief  ,     .
+    @retval  -  .
+**/
+qint64 SensorLogReader::getErrorCount() const {
+	return errorCount;
+}
+
+/**
+    @brief  ,     .
+    @param  samples  - ,    .
+    @param  capacity -   .
+    @param  interval -      .
+	   ,     ,
+	    .    0.
+    @retval          -   , 0   .
+**/
+int SensorLogReader::read(SensorSample* samples, int capacity, double interval) {
+	int count = 0;
+	SensorSample sample;
+	while (count < capacity && cursor < end) {
+		if (!parseRow(sample)) {
+			continue;
+		}
+		rowCount++;
+		if (interval <= 0.0) {
+			samples[count++] = sample;
+			continue;
+		}
+		if (windowCount > 0 && sample.timestamp >= windowStart + interval) {
+			flushWindow(samples[count++]);
+		}
+		if (windowCount == 0) {
+			windowStart = sample.timestamp;
+		}
+		windowSum.timestamp += sample.timestamp;
+		windowSum.temperature += sample.temperature;
+		windowSum.humidity += sample.humidity;
+		windowSum.pressure += sample.pressure;
+		windowCount++;
+	}
+	if (count < capacity && cursor == end && windowCount > 0) {
+		flushWindow(samples[count++]);
+	}
+	return count;
+}
+
+/**
+    @brief  ,   ,    ,
+	     .   ,
+	      .
+    @param  sample - ,     .
+    @retval        -  true,   ,   false.
+**/
+bool SensorLogReader::parseRow(SensorSample& sample) {
+	while (cursor < end && (*cursor == '\n' || *cursor == '\r')) {
+		cursor++;
+	}
+	if (cursor == end) {
+		return false;
+	}
+	double* fields[] = { &sample.timestamp, &sample.temperature, &sample.humidity, &sample.pressure };
+	const char* p = cursor;
+	for (int i = 0; i < 4; i++) {
+		const char* delimiter = findDelimiter(p, end);
+		bool lastField = i == 3;
+		bool lineEnds = delimiter == end || *delimiter == '\n';
+		if (lineEnds != lastField || !parseNumber(p, delimiter, *fields[i])) {
+			errorCount++;
+			if (lineEnds) {
+				cursor = delimiter == end ? end : delimiter + 1;
+			}
+			else {
+				skipLine(delimiter);
+			}
+			return false;
+		}
+		p = delimiter == end ? end : delimiter + 1;
+	}
+	cursor = p;
+	return true;
+}
+
+/**
+    @brief ,     ,   
+	.
+    @param from -    .
+**/
+void SensorLogReader::skipLine(const char* from) {
+	const char* newline = static_cast<const char*>(std::memchr(from, '\n', size_t(end - from)));
+	cursor = newline == nullptr ? end : newline + 1;
+}
+
+/**
+    @brief ,     
+	   .
+    @param sample - ,     .
+**/
+void SensorLogReader::flushWindow(SensorSample& sample) {
+	sample.timestamp = windowSum.timestamp / windowCount;
+	sample.temperature = windowSum.temperature / windowCount;
+	sample.humidity = windowSum.humidity / windowCount;
+	sample.pressure = windowSum.pressure / windowCount;
+	windowSum = SensorSample{ 0.0, 0.0, 0.0, 0.0 };
+	windowCount = 0;
+}
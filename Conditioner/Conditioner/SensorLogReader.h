@@ -0,0 +1,59 @@
+#pragma once
+#include <QFile>
+#include <QString>
+
+/**
+	@struct  SensorSample
+	@brief          .
+**/
+struct SensorSample {
+	double timestamp;
+	double temperature;
+	double humidity;
+	double pressure;
+};
+
+/**
+
+	@class   SensorLogReader
+	@brief   ,       
+	CSV (  ,    ,   ,
+	  ).     ,   
+	 16     SSE2,     
+	.   :     
+	   .
+
+**/
+class SensorLogReader {
+public:
+	SensorLogReader(const QString& path);
+	~SensorLogReader();
+
+	bool open();
+	void close();
+	bool isOpen() const;
+	bool atEnd() const;
+
+	qint64 getSize() const;
+	qint64 getRowCount() const;
+	qint64 getErrorCount() const;
+
+	int read(SensorSample* samples, int capacity, double interval = 0.0);
+
+private:
+	bool parseRow(SensorSample& sample);
+	void skipLine(const char* from);
+	void flushWindow(SensorSample& sample);
+
+	QFile file;
+	const char* begin;
+	const char* cursor;
+	const char* end;
+
+	qint64 rowCount;
+	qint64 errorCount;
+
+	SensorSample windowSum;
+	double windowStart;
+	int windowCount;
+};
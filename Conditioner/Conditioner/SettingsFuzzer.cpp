@@ -0,0 +1,245 @@
+#include "SettingsFuzzer.h"
+#include "SettingsStore.h"
+#include <QFile>
+#include <QXmlStreamWriter>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+
+/**
+    @brief ,     :  XML,
+	     
+	 UTF-8.
+**/
+const char mutationBytes[] = { '<', '>', '/', '"', '\'', '=', '&', ';', '#', '\\', '\t', '\n', '\r', ' ', '\0', '0', '9',
+	'\x7F', '\x80', '\xC3', '\xED', '\xEF', '\xFF' };
+
+/**
+    @brief ,   :    
+	,   ,   XML,  ,
+	       UTF-8.
+**/
+const char* const mutationTokens[] = { "<settings sequence=\"", "</settings>", "<value key=\"", "\" text=\"", "\"/>",
+	"<celsiusButton/>", "<temperatureLabel text=\"", "<energyMeter kWh=\"", "zone.0.temperature", "energyMeter",
+	"&amp;", "&lt;", "&quot;", "&#1;", "&#x0;", "&#xD800;", "&#65535;", "&#x10FFFF;", "&undefined;",
+	"<!DOCTYPE settings [<!ENTITY e \"&#38;e;&#38;e;\">]>", "&e;", "<![CDATA[", "]]>", "<!--", "-->", "<?pi?>",
+	"\\", "\\t", "\\n", "\\x", "\t", "\n", "\r\n", "0\t", "18446744073709551615", "18446744073709551616", "-1",
+	"\xC3", "\xED\xA0\x80", "\xEF\xBF\xBF", "\xF4\x90\x80\x80" };
+
+}
+
+/**
+    @brief   .
+    @param seed -    ;   
+	  .
+**/
+SettingsFuzzer::SettingsFuzzer(quint64 seed)
+	: state(seed) {
+}
+
+/**
+    @brief  ,  :      
+	,  , ,     
+	    .
+    @param  data -  .
+    @retval      -  .
+**/
+QByteArray SettingsFuzzer::mutate(const QByteArray& data) {
+	QByteArray result = data;
+	int count = 1 + random(4);
+	for (int i = 0; i < count; i++) {
+		int position = random(result.size() + 1);
+		bool inside = position < result.size();
+		switch (random(6)) {
+		case 0:
+			if (inside) {
+				result[position] = char(result.at(position) ^ (1 << random(8)));
+			}
+			break;
+		case 1:
+			if (inside) {
+				result[position] = mutationBytes[random(int(sizeof(mutationBytes)))];
+			}
+			break;
+		case 2:
+			result.remove(position, 1 + random(16));
+			break;
+		case 3:
+			result.insert(position, result.mid(random(result.size() + 1), 1 + random(64)));
+			break;
+		case 4:
+			result.insert(position, mutationTokens[random(int(sizeof(mutationTokens) / sizeof(mutationTokens[0])))]);
+			break;
+		default:
+			result.truncate(position);
+			break;
+		}
+	}
+	return result;
+}
+
+/**
+    @brief  ,     ,   
+	   .
+    @param  data -  .
+    @retval      -    ,  .
+**/
+QByteArray SettingsFuzzer::tear(const QByteArray& data) {
+	return data.left(random(data.size()));
+}
+
+/**
+    @brief  ,   .    
+	   ,     ,   
+	   ;   
+	     .
+    @param  data -  .
+    @retval      -  true,      
+	       ,  false.
+**/
+bool SettingsFuzzer::checkInput(const QByteArray& data) {
+	QHash<QString, QString> values;
+	quint64 sequence = 0;
+	SettingsStore::parseSnapshot(data, values, sequence);
+	SettingsStore::parseJournal(data, 0, values, sequence);
+	QHash<QString, QString> reloaded;
+	quint64 reloadedSequence = 0;
+	bool valid = SettingsStore::parseSnapshot(SettingsStore::formatSnapshot(values, sequence), reloaded, reloadedSequence);
+	return valid && reloaded == values && reloadedSequence == sequence;
+}
+
+/**
+    @brief  ,    :  
+	   , ,     
+	 ,     . 
+	    ,      
+	:       .
+    @param  data -  .
+    @param  path -    ;     
+	.
+    @retval      -  false,      
+	  ,     ,  true.
+**/
+bool SettingsFuzzer::checkJournalAppend(const QByteArray& data, const QString& path) {
+	QFile::remove(path);
+	QFile::remove(path + ".compacting");
+	QFile journal(path + ".journal");
+	if (!journal.open(QFile::WriteOnly) || journal.write(data) != data.size()) {
+		return false;
+	}
+	journal.close();
+	QHash<QString, QString> values;
+	quint64 sequence = 0;
+	{
+		SettingsStore store(path);
+		store.load();
+		store.setValue("fuzz.appended", store.value("fuzz.appended") + "1");
+		if (!store.commit()) {
+			return false;
+		}
+		store.waitForCompaction();
+		values = store.getValues();
+		sequence = store.getSequence();
+	}
+	SettingsStore reloaded(path);
+	return reloaded.load() && reloaded.getValues() == values && reloaded.getSequence() == sequence;
+}
+
+/**
+    @brief  ,    , 
+	     .
+    @param  zones -  .
+    @retval       -    .
+**/
+QHash<QString, QString> SettingsFuzzer::generateValues(int zones) {
+	static const char* const temperatureModes[] = { "celsiusButton", "fahrenheitButton", "kelvinButton" };
+	static const char* const pressureModes[] = { "mmHgButton", "pascalButton" };
+	static const char* const directions[] = { "leftDirButton", "centerDirButton", "rightDirButton" };
+	QHash<QString, QString> values;
+	values.insert("theme", "darkToggle");
+	values.insert("energyMeter", QString::number(zones * 0.125, 'f', 6));
+	for (int zone = 0; zone < zones; zone++) {
+		values.insert(SettingsStore::zoneKey(zone, "temperature"), QString::number(16 + zone % 15));
+		values.insert(SettingsStore::zoneKey(zone, "temperatureMode"), temperatureModes[zone % 3]);
+		values.insert(SettingsStore::zoneKey(zone, "humidity"), QString::number(30 + zone % 40) + "%");
+		values.insert(SettingsStore::zoneKey(zone, "pressure"), QString::number(740 + zone % 40));
+		values.insert(SettingsStore::zoneKey(zone, "pressureMode"), pressureModes[zone % 2]);
+		values.insert(SettingsStore::zoneKey(zone, "direction"), directions[zone % 3]);
+	}
+	return values;
+}
+
+/**
+    @brief  ,  ,    
+	      .
+    @param  zones   -  .
+    @param  records -  .
+    @retval         -  .
+**/
+QByteArray SettingsFuzzer::generateJournal(int zones, int records) {
+	QByteArray data;
+	for (int i = 0; i < records; i++) {
+		data += QByteArray::number(i + 1) + '\t' + SettingsStore::zoneKey(i % qMax(zones, 1), "temperature").toUtf8() + '\t'
+			+ QByteArray::number(16 + i % 15) + "\tenergyMeter\t" + QByteArray::number(i * 0.001, 'f', 6) + '\n';
+	}
+	return data;
+}
+
+/**
+    @brief  ,     ,  
+	    .
+    @retval  -  .
+**/
+QByteArray SettingsFuzzer::generateLegacySnapshot() {
+	QByteArray data;
+	QXmlStreamWriter writer(&data);
+	writer.setAutoFormatting(true);
+	writer.writeStartDocument();
+	writer.writeStartElement("settings");
+	writer.writeEmptyElement("darkToggle");
+	writer.writeEmptyElement("fahrenheitButton");
+	writer.writeEmptyElement("temperatureLabel");
+	writer.writeAttribute("text", "71.6");
+	writer.writeEmptyElement("humidityLabel");
+	writer.writeAttribute("text", "45%");
+	writer.writeEmptyElement("pressureLabel");
+	writer.writeAttribute("text", "101325");
+	writer.writeEmptyElement("pascalButton");
+	writer.writeEmptyElement("rightDirButton");
+	writer.writeEmptyElement("energyMeter");
+	writer.writeAttribute("kWh", "12.500000");
+	writer.writeEndElement();
+	writer.writeEndDocument();
+	return data;
+}
+
+/**
+    @brief  ,   .
+    @param  size -   .
+    @retval      -     [0; size).
+**/
+int SettingsFuzzer::random(int size) {
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return int((state >> 33) % quint64(qMax(size, 1)));
+}
+
+#ifdef CONDITIONER_FUZZER
+/**
+    @brief    libFuzzer.   checkInput 
+	,  libFuzzer    .
+    @param  data - ,  libFuzzer.
+    @param  size -    .
+    @retval      -  0.
+**/
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	if (size > size_t(std::numeric_limits<int>::max())) {
+		return 0;
+	}
+	if (!SettingsFuzzer::checkInput(QByteArray::fromRawData(reinterpret_cast<const char*>(data), int(size)))) {
+		abort();
+	}
+	return 0;
+}
+#endif
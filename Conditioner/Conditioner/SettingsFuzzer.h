@@ -0,0 +1,39 @@
+#pragma once
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+/**
+
+	@class   SettingsFuzzer
+	@brief          
+	.       ,  
+	;      ,  
+	       .  
+	    ,     
+	SettingsStore    .   
+	 fuzz,     
+	 ,      CONDITIONER_FUZZER - 
+	  libFuzzer LLVMFuzzerTestOneInput, :
+	clang++ -fsanitize=fuzzer,address -DCONDITIONER_FUZZER SettingsFuzzer.cpp
+	SettingsStore.cpp AppData.cpp   QtCore.
+
+**/
+class SettingsFuzzer {
+public:
+	SettingsFuzzer(quint64 seed);
+
+	QByteArray mutate(const QByteArray& data);
+	QByteArray tear(const QByteArray& data);
+
+	static bool checkInput(const QByteArray& data);
+	static bool checkJournalAppend(const QByteArray& data, const QString& path);
+	static QHash<QString, QString> generateValues(int zones);
+	static QByteArray generateJournal(int zones, int records);
+	static QByteArray generateLegacySnapshot();
+
+private:
+	int random(int size);
+
+	quint64 state;
+};
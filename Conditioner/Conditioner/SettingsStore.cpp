@@ -0,0 +1,492 @@
+#include "SettingsStore.h"
+#include "AppData.h"
+#include <QSaveFile>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <algorithm>
+
+namespace {
+
+/**
+    @brief  ,     :  
+	,      
+	.
+    @param  text -  .
+    @retval      -    UTF-8     .
+**/
+QByteArray escape(const QString& text) {
+	QByteArray data = text.toUtf8();
+	data.replace('\\', "\\\\");
+	data.replace('\t', "\\t");
+	data.replace('\n', "\\n");
+	return data;
+}
+
+/**
+    @brief  ,  ,   escape.
+    @param  data -  .
+    @param  text - ,    .
+    @retval      -  true,    ,  false.
+**/
+bool unescape(const QByteArray& data, QString& text) {
+	QByteArray result;
+	result.reserve(data.size());
+	for (int i = 0; i < data.size(); i++) {
+		if (data[i] != '\\') {
+			result.append(data[i]);
+			continue;
+		}
+		if (++i == data.size()) {
+			return false;
+		}
+		switch (data[i]) {
+		case '\\': result.append('\\'); break;
+		case 't': result.append('\t'); break;
+		case 'n': result.append('\n'); break;
+		default: return false;
+		}
+	}
+	text = QString::fromUtf8(result);
+	return true;
+}
+
+/**
+    @brief  ,  ,   XML,  U+FFFD.
+	      ,    
+	    .
+    @param  text -  .
+    @retval      - ,      XML.
+**/
+QString toXmlText(const QString& text) {
+	QString result = text;
+	for (int i = 0; i < result.size(); i++) {
+		ushort code = result.at(i).unicode();
+		if (QChar::isHighSurrogate(code) && i + 1 < result.size() && QChar::isLowSurrogate(result.at(i + 1).unicode())) {
+			i++;
+			continue;
+		}
+		if ((code < 0x20 && code != '\t' && code != '\n' && code != '\r') || QChar::isSurrogate(code) || code > 0xFFFD) {
+			result[i] = QChar::ReplacementCharacter;
+		}
+	}
+	return result;
+}
+
+/**
+    @brief  ,      , 
+	     :   -
+	   ,  -     
+	 text,   -  energyMeter.
+    @param  reader -  XML,    .
+    @param  key    - ,    .
+    @param  value  - ,    .
+    @retval        -  true,   ,  false.
+**/
+bool readLegacyElement(const QXmlStreamReader& reader, QString& key, QString& value) {
+	QStringRef name = reader.name();
+	value = name.toString();
+	if (name == "lightToggle" || name == "darkToggle") {
+		key = "theme";
+	}
+	else if (name == "celsiusButton" || name == "fahrenheitButton" || name == "kelvinButton") {
+		key = SettingsStore::zoneKey(0, "temperatureMode");
+	}
+	else if (name == "mmHgButton" || name == "pascalButton") {
+		key = SettingsStore::zoneKey(0, "pressureMode");
+	}
+	else if (name == "leftDirButton" || name == "centerDirButton" || name == "rightDirButton") {
+		key = SettingsStore::zoneKey(0, "direction");
+	}
+	else if (name == "temperatureLabel" || name == "humidityLabel" || name == "pressureLabel") {
+		key = SettingsStore::zoneKey(0, value.chopped(5));
+		value = reader.attributes().value("text").toString();
+	}
+	else if (name == "energyMeter") {
+		key = value;
+		value = reader.attributes().value("kWh").toString();
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+}
+
+/**
+    @brief   .      load().
+    @param path -    ;     .
+**/
+SettingsStore::SettingsStore(const QString& path)
+	: path(path), compactingPath(path + ".compacting"), journal(path + ".journal"), sequence(0), snapshotBytes(0),
+	journalBytes(0), writtenBytes(0), damaged(false), compactedBytes(-1), compactionCount(0) {
+}
+
+/**
+    @brief   .   .
+**/
+SettingsStore::~SettingsStore() {
+	waitForCompaction();
+	journal.close();
+}
+
+/**
+    @brief  ,        
+	  :     , 
+	 ,   .   ,  
+	  -.
+    @retval  -  false,       
+	,  true.     ,
+	       .
+**/
+bool SettingsStore::load() {
+	waitForCompaction();
+	journal.close();
+	values.clear();
+	pending.clear();
+	sequence = 0;
+	snapshotBytes = 0;
+	journalBytes = 0;
+	QFile snapshotFile(path);
+	QFile compactingFile(compactingPath);
+	bool found = false;
+	bool valid = true;
+	if (snapshotFile.open(QFile::ReadOnly)) {
+		QByteArray data = snapshotFile.readAll();
+		snapshotBytes = data.size();
+		valid = parseSnapshot(data, values, sequence);
+		found = true;
+	}
+	quint64 snapshotSequence = sequence;
+	if (compactingFile.open(QFile::ReadOnly)) {
+		valid = parseJournal(compactingFile.readAll(), snapshotSequence, values, sequence) && valid;
+		compactingFile.close();
+		found = true;
+	}
+	if (journal.open(QFile::ReadOnly)) {
+		QByteArray data = journal.readAll();
+		journalBytes = data.size();
+		valid = parseJournal(data, snapshotSequence, values, sequence) && valid;
+		journal.close();
+		found = true;
+	}
+	damaged = found && !valid;
+	return found && valid;
+}
+
+/**
+    @brief  ,   .
+    @param  key          - .
+    @param  defaultValue - ,    .
+    @retval              -  .
+**/
+QString SettingsStore::value(const QString& key, const QString& defaultValue) const {
+	return values.value(key, defaultValue);
+}
+
+/**
+    @brief  ,      .
+    @retval  -    .
+**/
+const QHash<QString, QString>& SettingsStore::getValues() const {
+	return values;
+}
+
+/**
+    @brief ,   .   
+	   commit(); ,   , 
+	. ,   XML,   U+FFFD.
+    @param key   - .
+    @param value -  .
+**/
+void SettingsStore::setValue(const QString& key, const QString& value) {
+	QString name = toXmlText(key);
+	QString text = toXmlText(value);
+	QHash<QString, QString>::iterator it = values.find(name);
+	if (it != values.end() && it.value() == text) {
+		return;
+	}
+	values.insert(name, text);
+	pending.insert(name, text);
+}
+
+/**
+    @brief  ,        ,
+	   .    
+	 ,   :  
+	    ,    
+	  .       
+	SETTINGS_JOURNAL_LIMIT,  .   
+	 .
+    @retval  -  true,      ,  false.
+**/
+bool SettingsStore::commit() {
+	if (pending.isEmpty()) {
+		return true;
+	}
+	if (damaged) {
+		damaged = false;
+		compact();
+	}
+	if (!journal.isOpen() && !openJournal()) {
+		return false;
+	}
+	QByteArray record = QByteArray::number(sequence + 1);
+	for (QHash<QString, QString>::const_iterator it = pending.constBegin(); it != pending.constEnd(); ++it) {
+		record += '\t' + escape(it.key()) + '\t' + escape(it.value());
+	}
+	record += '\n';
+	if (journal.write(record) != record.size() || !journal.flush()) {
+		if (!journal.resize(journalBytes) || !journal.seek(journalBytes)) {
+			journal.close();
+		}
+		return false;
+	}
+	sequence++;
+	pending.clear();
+	journalBytes += record.size();
+	writtenBytes += record.size();
+	qint64 compacted = compactedBytes.exchange(-1);
+	if (compacted >= 0) {
+		snapshotBytes = compacted;
+	}
+	if (journalBytes > qMax(qint64(SETTINGS_JOURNAL_LIMIT), snapshotBytes)) {
+		compact();
+	}
+	return true;
+}
+
+/**
+    @brief  ,    .  
+	,    , , 
+	     .   
+	,  ,   ,   .    ,
+	     .
+    @retval  -  true,   ,  false.
+**/
+bool SettingsStore::openJournal() {
+	if (!journal.open(QFile::ReadWrite | QFile::Unbuffered)) {
+		return false;
+	}
+	qint64 size = journal.size();
+	qint64 end = size;
+	while (end > 0) {
+		qint64 chunk = qMin(end, qint64(4096));
+		if (!journal.seek(end - chunk)) {
+			journal.close();
+			return false;
+		}
+		int newline = journal.read(chunk).lastIndexOf('\n');
+		if (newline >= 0) {
+			end += newline + 1 - chunk;
+			break;
+		}
+		end -= chunk;
+	}
+	if ((end != size && !journal.resize(end)) || !journal.seek(end)) {
+		journal.close();
+		return false;
+	}
+	journalBytes = end;
+	return true;
+}
+
+/**
+    @brief ,  :  , 
+	   ,     
+	  ,     . 
+	   ,   , 
+	  .
+**/
+void SettingsStore::compact() {
+	waitForCompaction();
+	journal.close();
+	if (!QFile::exists(compactingPath) && QFile::exists(journal.fileName())) {
+		if (!QFile::rename(journal.fileName(), compactingPath)) {
+			return;
+		}
+		journalBytes = 0;
+	}
+	compactor = std::thread(&SettingsStore::writeSnapshot, this, values, sequence);
+}
+
+/**
+    @brief ,   ,   .
+**/
+void SettingsStore::waitForCompaction() {
+	if (compactor.joinable()) {
+		compactor.join();
+	}
+	qint64 compacted = compactedBytes.exchange(-1);
+	if (compacted >= 0) {
+		snapshotBytes = compacted;
+	}
+}
+
+/**
+    @brief  ,     .
+    @retval  -  .
+**/
+quint64 SettingsStore::getSequence() const {
+	return sequence;
+}
+
+/**
+    @brief  ,    .
+    @retval  -   .
+**/
+qint64 SettingsStore::getJournalBytes() const {
+	return journalBytes;
+}
+
+/**
+    @brief  ,  ,      .
+    @retval  -   .
+**/
+qint64 SettingsStore::getWrittenBytes() const {
+	return writtenBytes;
+}
+
+/**
+    @brief  ,    .
+    @retval  -  .
+**/
+int SettingsStore::getCompactionCount() const {
+	return compactionCount.load();
+}
+
+/**
+    @brief  ,     .
+    @param  zone  -  .
+    @param  field -  .
+    @retval       -   zone.<>.<>.
+**/
+QString SettingsStore::zoneKey(int zone, const QString& field) {
+	return QString("zone.%1.%2").arg(zone).arg(field);
+}
+
+/**
+    @brief  ,   .   value 
+	 key  text,     .  
+	   ,    
+	     .
+    @param  data     -  .
+    @param  values   - ,    .
+    @param  sequence - ,     
+	 ,   ; 0    .
+    @retval          -  true,     ,  false.
+**/
+bool SettingsStore::parseSnapshot(const QByteArray& data, QHash<QString, QString>& values, quint64& sequence) {
+	QXmlStreamReader reader(data);
+	sequence = 0;
+	while (!reader.atEnd() && reader.readNext() != QXmlStreamReader::StartElement) {
+		if (reader.tokenType() == QXmlStreamReader::DTD) {
+			return false;
+		}
+	}
+	if (!reader.isStartElement() || reader.name() != QLatin1String("settings")) {
+		return false;
+	}
+	sequence = reader.attributes().value(QLatin1String("sequence")).toULongLong();
+	while (reader.readNextStartElement()) {
+		QString key;
+		QString value;
+		if (reader.name() == QLatin1String("value")) {
+			QXmlStreamAttributes attributes = reader.attributes();
+			if (attributes.hasAttribute(QLatin1String("key"))) {
+				values.insert(toXmlText(attributes.value(QLatin1String("key")).toString()),
+					toXmlText(attributes.value(QLatin1String("text")).toString()));
+			}
+		}
+		else if (readLegacyElement(reader, key, value)) {
+			values.insert(toXmlText(key), toXmlText(value));
+		}
+		reader.skipCurrentElement();
+	}
+	return !reader.hasError();
+}
+
+/**
+    @brief  ,   .    
+	    .
+    @param  data     -  .
+    @param  after    -   ,   ; 
+	  .
+    @param  values   - ,    .
+    @param  sequence -   ;   
+	 .
+    @retval          -  false,   
+	,  true.     .
+**/
+bool SettingsStore::parseJournal(const QByteArray& data, quint64 after, QHash<QString, QString>& values, quint64& sequence) {
+	int start = 0;
+	for (int end = data.indexOf('\n'); end >= 0; start = end + 1, end = data.indexOf('\n', start)) {
+		QList<QByteArray> fields = data.mid(start, end - start).split('\t');
+		bool ok = false;
+		quint64 number = fields[0].toULongLong(&ok);
+		if (!ok || fields.size() % 2 == 0) {
+			return false;
+		}
+		QHash<QString, QString> changes;
+		for (int i = 1; i < fields.size(); i += 2) {
+			QString key;
+			QString value;
+			if (!unescape(fields[i], key) || !unescape(fields[i + 1], value)) {
+				return false;
+			}
+			changes.insert(toXmlText(key), toXmlText(value));
+		}
+		if (number > after) {
+			for (QHash<QString, QString>::const_iterator it = changes.constBegin(); it != changes.constEnd(); ++it) {
+				values.insert(it.key(), it.value());
+			}
+		}
+		sequence = qMax(sequence, number);
+	}
+	return true;
+}
+
+/**
+    @brief  ,   .  , 
+	    .
+    @param  values   -  .
+    @param  sequence -    ,   .
+    @retval          -   .
+**/
+QByteArray SettingsStore::formatSnapshot(const QHash<QString, QString>& values, quint64 sequence) {
+	QList<QString> keys = values.keys();
+	std::sort(keys.begin(), keys.end());
+	QByteArray data;
+	QXmlStreamWriter writer(&data);
+	writer.setAutoFormatting(true);
+	writer.writeStartDocument();
+	writer.writeStartElement("settings");
+	writer.writeAttribute("sequence", QString::number(sequence));
+	for (const QString& key : keys) {
+		writer.writeEmptyElement("value");
+		writer.writeAttribute("key", key);
+		writer.writeAttribute("text", values.value(key));
+	}
+	writer.writeEndElement();
+	writer.writeEndDocument();
+	return data;
+}
+
+/**
+    @brief ,       ,
+	   .    ,
+	        
+	 .
+    @param snapshot         -   .
+    @param snapshotSequence -    ,   .
+**/
+void SettingsStore::writeSnapshot(const QHash<QString, QString>& snapshot, quint64 snapshotSequence) {
+	QByteArray data = formatSnapshot(snapshot, snapshotSequence);
+	QSaveFile file(path);
+	if (!file.open(QFile::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+		return;
+	}
+	QFile::remove(compactingPath);
+	compactedBytes.store(data.size());
+	compactionCount++;
+}
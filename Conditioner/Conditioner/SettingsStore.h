@@ -0,0 +1,69 @@
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <atomic>
+#include <thread>
+
+/**
+
+	@class   SettingsStore
+	@brief         -  
+	  .       
+	  XML,        path.journal
+	 ,    ,  
+	  ,    .  
+	  ,    path.compacting, 
+	     .  ,  
+	     ,  
+	     .    
+	 ,     , 
+	     .
+
+**/
+class SettingsStore {
+public:
+	SettingsStore(const QString& path);
+	~SettingsStore();
+
+	bool load();
+
+	QString value(const QString& key, const QString& defaultValue = QString()) const;
+	const QHash<QString, QString>& getValues() const;
+	void setValue(const QString& key, const QString& value);
+	bool commit();
+
+	void compact();
+	void waitForCompaction();
+
+	quint64 getSequence() const;
+	qint64 getJournalBytes() const;
+	qint64 getWrittenBytes() const;
+	int getCompactionCount() const;
+
+	static QString zoneKey(int zone, const QString& field);
+	static bool parseSnapshot(const QByteArray& data, QHash<QString, QString>& values, quint64& sequence);
+	static bool parseJournal(const QByteArray& data, quint64 after, QHash<QString, QString>& values, quint64& sequence);
+	static QByteArray formatSnapshot(const QHash<QString, QString>& values, quint64 sequence);
+
+private:
+	bool openJournal();
+	void writeSnapshot(const QHash<QString, QString>& snapshot, quint64 snapshotSequence);
+
+	QString path;
+	QString compactingPath;
+	QFile journal;
+
+	QHash<QString, QString> values;
+	QHash<QString, QString> pending;
+	quint64 sequence;
+	qint64 snapshotBytes;
+	qint64 journalBytes;
+	qint64 writtenBytes;
+	bool damaged;
+
+	std::thread compactor;
+	std::atomic<qint64> compactedBytes;
+	std::atomic<int> compactionCount;
+};
@@ -0,0 +1,116 @@
+#include "StartupTrace.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+/**
+    @brief   .     
+	 .
+**/
+StartupTrace::StartupTrace() : lastMark(0) {
+	getClock();
+}
+
+/**
+    @brief ,    .  
+	  main;   ,    
+	.
+**/
+void StartupTrace::start() {
+	getClock();
+}
+
+/**
+    @brief ,  ,     
+	 .
+    @param phase -  .
+**/
+void StartupTrace::record(const QString& phase) {
+	qint64 now = getElapsed();
+	events.append({ phase, lastMark, now - lastMark, false });
+	lastMark = now;
+}
+
+/**
+    @brief ,   ,   
+	.     .
+    @param name -  .
+**/
+void StartupTrace::mark(const QString& name) {
+	events.append({ name, getElapsed(), 0, true });
+}
+
+/**
+    @brief  ,     .
+    @retval  -    .
+**/
+const QVector<TraceEvent>& StartupTrace::getEvents() const {
+	return events;
+}
+
+/**
+    @brief  ,     Chrome Trace Event: 
+	   (ph = X),  -  (ph = i).
+    @retval  -  JSON.
+**/
+QByteArray StartupTrace::toJson() const {
+	QJsonArray traceEvents;
+	qint64 pid = QCoreApplication::applicationPid();
+	for (const TraceEvent& event : events) {
+		QJsonObject object;
+		object.insert("name", event.name);
+		object.insert("cat", "startup");
+		object.insert("ph", event.instant ? "i" : "X");
+		object.insert("ts", double(event.begin));
+		if (event.instant) {
+			object.insert("s", "p");
+		}
+		else {
+			object.insert("dur", double(event.duration));
+		}
+		object.insert("pid", double(pid));
+		object.insert("tid", 0);
+		traceEvents.append(object);
+	}
+	QJsonObject document;
+	document.insert("traceEvents", traceEvents);
+	document.insert("displayTimeUnit", "ms");
+	return QJsonDocument(document).toJson(QJsonDocument::Compact);
+}
+
+/**
+    @brief  ,    .
+    @param  path -   .
+    @retval      -  true,   ,  false.
+**/
+bool StartupTrace::write(const QString& path) const {
+	QFile file(path);
+	if (!file.open(QFile::WriteOnly)) {
+		return false;
+	}
+	QByteArray data = toJson();
+	return file.write(data) == data.size();
+}
+
+/**
+    @brief  ,      .
+    @retval  -   .
+**/
+qint64 StartupTrace::getElapsed() {
+	return getClock().nsecsElapsed() / 1000;
+}
+
+/**
+    @brief  ,   ,    
+	.
+    @retval  -  .
+**/
+QElapsedTimer& StartupTrace::getClock() {
+	static QElapsedTimer clock;
+	if (!clock.isValid()) {
+		clock.start();
+	}
+	return clock;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+
+/**
+	@struct  TraceEvent
+	@brief     :    
+	 .      
+	 .
+**/
+struct TraceEvent {
+	QString name;
+	qint64 begin;
+	qint64 duration;
+	bool instant;
+};
+
+/**
+
+	@class   StartupTrace
+	@brief   ,    .   
+	    record(),     
+	  .     Chrome Trace Event
+	   chrome://tracing  Perfetto.
+
+**/
+class StartupTrace {
+public:
+	StartupTrace();
+
+	static void start();
+
+	void record(const QString& phase);
+	void mark(const QString& name);
+
+	const QVector<TraceEvent>& getEvents() const;
+	QByteArray toJson() const;
+	bool write(const QString& path) const;
+
+	static qint64 getElapsed();
+
+private:
+	static QElapsedTimer& getClock();
+
+	qint64 lastMark;
+	QVector<TraceEvent> events;
+};
@@ -0,0 +1,119 @@
+#include "StateHistory.h"
+
+/**
+    @brief     .
+    @param  other -   .
+    @retval       -  true,    ,  false.
+**/
+bool ZoneState::operator==(const ZoneState& other) const {
+	return temperature == other.temperature && temperatureMode == other.temperatureMode && pressureMode == other.pressureMode
+		&& direction == other.direction;
+}
+
+/**
+    @brief       .
+    @param  other -   .
+    @retval       -  true,      ,
+	 false.
+**/
+bool ZoneState::operator!=(const ZoneState& other) const {
+	return !(*this == other);
+}
+
+/**
+    @brief    .   
+	 .
+    @param limit -    .
+**/
+StateHistory::StateHistory(int limit) : states(qMax(limit, 1)), first(0), count(1), index(0) {
+}
+
+/**
+    @brief ,       .
+    @param state -   .
+**/
+void StateHistory::reset(const ControllerState& state) {
+	states.fill(ControllerState());
+	first = 0;
+	count = 1;
+	index = 0;
+	states[0] = state;
+}
+
+/**
+    @brief ,    . ,  
+	 , .      
+	 .
+    @param state -   .
+**/
+void StateHistory::push(const ControllerState& state) {
+	for (int position = index + 1; position < count; position++) {
+		states[slot(position)] = ControllerState();
+	}
+	count = index + 1;
+	if (count == states.size()) {
+		first = slot(1);
+		count--;
+	}
+	states[slot(count)] = state;
+	index = count++;
+}
+
+/**
+    @brief  ,     .
+    @retval  -  true,    ,  false.
+**/
+bool StateHistory::canUndo() const {
+	return index > 0;
+}
+
+/**
+    @brief  ,     .
+    @retval  -  true,    ,  false.
+**/
+bool StateHistory::canRedo() const {
+	return index < count - 1;
+}
+
+/**
+    @brief  ,   .   
+	 canUndo().
+    @retval  - ,  .
+**/
+const ControllerState& StateHistory::undo() {
+	return states.at(slot(--index));
+}
+
+/**
+    @brief  ,   .   
+	 canRedo().
+    @retval  - ,  .
+**/
+const ControllerState& StateHistory::redo() {
+	return states.at(slot(++index));
+}
+
+/**
+    @brief  ,    .
+    @retval  -  .
+**/
+const ControllerState& StateHistory::current() const {
+	return states.at(slot(index));
+}
+
+/**
+    @brief  ,    .
+    @retval  -  .
+**/
+int StateHistory::getSize() const {
+	return count;
+}
+
+/**
+    @brief  ,        .
+    @param  position -  , 0 -  .
+    @retval          -    .
+**/
+int StateHistory::slot(int position) const {
+	return (first + position) % states.size();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <QString>
+#include <QVector>
+#include "PersistentVector.h"
+
+/**
+	@struct  ZoneState
+	@brief      ,  ,
+	  ,        .
+	        , 
+	      . 
+	  ,    - 
+	 ,     
+	      .
+**/
+struct ZoneState {
+	QString temperature;
+	QString temperatureMode;
+	QString pressureMode;
+	QString direction;
+
+	bool operator==(const ZoneState& other) const;
+	bool operator!=(const ZoneState& other) const;
+};
+
+/**
+	@struct  ControllerState
+	@brief      .    
+	  ,      
+	 .
+**/
+struct ControllerState {
+	PersistentVector<ZoneState> zones;
+};
+
+/**
+
+	@class   StateHistory
+	@brief   ,       
+	  .      .
+	    ,    
+	      .
+
+**/
+class StateHistory {
+public:
+	StateHistory(int limit);
+
+	void reset(const ControllerState& state);
+	void push(const ControllerState& state);
+
+	bool canUndo() const;
+	bool canRedo() const;
+	const ControllerState& undo();
+	const ControllerState& redo();
+
+	const ControllerState& current() const;
+	int getSize() const;
+
+private:
+	int slot(int position) const;
+
+	QVector<ControllerState> states;
+	int first;
+	int count;
+	int index;
+};
@@ -0,0 +1,202 @@
+#include "StateSegment.h"
+#include "AppData.h"
+#include <QDebug>
+#include <QDir>
+#include <chrono>
+#include <cstring>
+
+static_assert(std::atomic<quint32>::is_always_lock_free, "seqlock counter must be lock-free to be shared between processes");
+
+/**
+    @brief   .    
+	    create()  attach().  
+	       
+	   -.
+    @param key -    .
+**/
+StateSegment::StateSegment(const QString& key) : memory(key), writerLock(QDir::temp().filePath(key + ".lock")), writer(false), layout(nullptr) {
+	writerLock.setStaleLockTime(0);
+}
+
+/**
+    @brief   .
+**/
+StateSegment::~StateSegment() {
+	detach();
+}
+
+/**
+    @brief  ,    .   
+	 ;     ,  
+	.     ,   
+	,      
+	    .
+    @retval  -  true,     ,  false.
+**/
+bool StateSegment::create() {
+	detach();
+	if (!writerLock.tryLock(0)) {
+		qWarning().noquote() << "state segment: already published by another controller";
+		return false;
+	}
+	if (!memory.create(int(sizeof(Layout)), QSharedMemory::ReadWrite)) {
+		if (memory.error() != QSharedMemory::AlreadyExists || !memory.attach(QSharedMemory::ReadWrite)) {
+			qWarning().noquote() << "state segment:" << memory.errorString();
+			writerLock.unlock();
+			return false;
+		}
+		if (memory.size() < int(sizeof(Layout))) {
+			memory.detach();
+			writerLock.unlock();
+			return false;
+		}
+	}
+	layout = static_cast<Layout*>(memory.data());
+	quint32 sequence = layout->sequence.load(std::memory_order_relaxed);
+	layout->sequence.store((sequence + 1) & ~1u, std::memory_order_relaxed);
+	layout->size = sizeof(Layout);
+	std::atomic_thread_fence(std::memory_order_release);
+	layout->magic = STATE_SEGMENT_MAGIC;
+	writer = true;
+	return true;
+}
+
+/**
+    @brief  ,      .
+	,      
+	 ,  .
+    @retval  -  true,   ,  false.
+**/
+bool StateSegment::attach() {
+	detach();
+	if (!memory.attach(QSharedMemory::ReadOnly)) {
+		return false;
+	}
+	layout = static_cast<Layout*>(const_cast<void*>(memory.constData()));
+	if (memory.size() < int(sizeof(Layout)) || layout->magic != STATE_SEGMENT_MAGIC || layout->size != sizeof(Layout)) {
+		detach();
+		return false;
+	}
+	return true;
+}
+
+/**
+    @brief ,      .
+**/
+void StateSegment::detach() {
+	if (memory.isAttached()) {
+		memory.detach();
+	}
+	if (writer) {
+		writerLock.unlock();
+	}
+	layout = nullptr;
+	writer = false;
+}
+
+/**
+    @brief  , ,   .
+    @retval  -  true,   ,  false.
+**/
+bool StateSegment::isAttached() const {
+	return layout != nullptr;
+}
+
+/**
+    @brief  , ,     .
+    @retval  -  true,    ,  false.
+**/
+bool StateSegment::isWriter() const {
+	return writer;
+}
+
+/**
+    @brief ,   .  
+	  .  ,    
+	,   .
+    @param state -  .
+**/
+void StateSegment::publish(const SharedPanelState& state) {
+	if (!writer) {
+		return;
+	}
+	quint32 sequence = layout->sequence.load(std::memory_order_relaxed);
+	layout->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	std::memcpy(&layout->state, &state, sizeof(SharedPanelState));
+	layout->state.publishedAt = getClock();
+	layout->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+    @brief  ,    ,   
+	 .    .   
+	  STATE_SEGMENT_READ_ATTEMPTS ,  
+	   .
+    @param  state    - ,    .
+    @param  sequence -    ; 
+	  .
+    @retval          -  true,    ,  false.
+**/
+bool StateSegment::read(SharedPanelState& state, quint32& sequence) const {
+	if (layout == nullptr) {
+		return false;
+	}
+	for (int attempt = 0; attempt < STATE_SEGMENT_READ_ATTEMPTS; attempt++) {
+		quint32 begin = layout->sequence.load(std::memory_order_acquire);
+		if (begin == sequence) {
+			return false;
+		}
+		if (begin & 1u) {
+			continue;
+		}
+		SharedPanelState snapshot;
+		std::memcpy(&snapshot, &layout->state, sizeof(SharedPanelState));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (layout->sequence.load(std::memory_order_relaxed) == begin) {
+			state = snapshot;
+			sequence = begin;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+    @brief  ,      .
+    @retval  -    0,    .
+**/
+quint32 StateSegment::getSequence() const {
+	return layout != nullptr ? layout->sequence.load(std::memory_order_acquire) : 0;
+}
+
+/**
+    @brief ,     . ,  
+	 , .
+    @param field -   SharedPanelState::TEXT_SIZE .
+    @param text  -  .
+**/
+void StateSegment::setText(char* field, const QString& text) {
+	QByteArray bytes = text.toUtf8();
+	int size = qMin(bytes.size(), SharedPanelState::TEXT_SIZE - 1);
+	std::memcpy(field, bytes.constData(), size_t(size));
+	std::memset(field + size, 0, size_t(SharedPanelState::TEXT_SIZE - size));
+}
+
+/**
+    @brief  ,     .
+    @param  field -   SharedPanelState::TEXT_SIZE .
+    @retval       -  .
+**/
+QString StateSegment::getText(const char* field) {
+	return QString::fromUtf8(field, int(strnlen(field, SharedPanelState::TEXT_SIZE)));
+}
+
+/**
+    @brief  ,    ,   
+	 .
+    @retval  -   .
+**/
+qint64 StateSegment::getClock() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <QLockFile>
+#include <QSharedMemory>
+#include <QString>
+#include <atomic>
+
+/**
+	@struct  SharedPanelState
+	@brief    ,   -.
+	   ,    :    
+	 , -       UTF-8,
+	      .
+**/
+struct SharedPanelState {
+	static const int TEXT_SIZE = 32;
+
+	char temperature[TEXT_SIZE];
+	char humidity[TEXT_SIZE];
+	char pressure[TEXT_SIZE];
+	char theme[TEXT_SIZE];
+	char temperatureMode[TEXT_SIZE];
+	char pressureMode[TEXT_SIZE];
+	char direction[TEXT_SIZE];
+	double consumedEnergy;
+	qint64 publishedAt;
+	quint8 power;
+	quint8 faults;
+};
+
+/**
+
+	@class   StateSegment
+	@brief   ,      .
+	         
+	seqlock:   ,   .  
+	          
+	; ,      ,
+	   .  :  
+	  ,     
+	 -.
+
+**/
+class StateSegment {
+public:
+	StateSegment(const QString& key);
+	~StateSegment();
+
+	bool create();
+	bool attach();
+	void detach();
+	bool isAttached() const;
+	bool isWriter() const;
+
+	void publish(const SharedPanelState& state);
+	bool read(SharedPanelState& state, quint32& sequence) const;
+	quint32 getSequence() const;
+
+	static void setText(char* field, const QString& text);
+	static QString getText(const char* field);
+	static qint64 getClock();
+
+private:
+	struct Layout {
+		quint32 magic;
+		quint32 size;
+		std::atomic<quint32> sequence;
+		SharedPanelState state;
+	};
+
+	QSharedMemory memory;
+	QLockFile writerLock;
+	bool writer;
+	Layout* layout;
+};
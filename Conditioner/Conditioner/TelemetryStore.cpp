@@ -0,0 +1,432 @@
+#include "TelemetryStore.h"
+#include "AppData.h"
+#include <QtAlgorithms>
+#include <cstring>
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+const int CHANNEL_COUNT = 3;
+//     :    64- 
+//        .
+const int MAX_POINT_BITS = (4 + 64) + CHANNEL_COUNT * (2 + 5 + 6 + 64);
+
+/**
+    @brief ,    ,   .
+	    .
+    @param data     - .
+    @param position -    ;   count.
+    @param value    -  .
+    @param count    -    ,  1  64.
+**/
+void writeBits(uchar* data, int& position, quint64 value, int count) {
+	while (count > 0) {
+		int free = 8 - (position & 7);
+		int n = qMin(free, count);
+		quint64 bits = (value >> (count - n)) & ((1u << n) - 1);
+		data[position >> 3] |= uchar(bits << (free - n));
+		position += n;
+		count -= n;
+	}
+}
+
+/**
+    @brief  ,    ,   .
+    @param  data     - .
+    @param  position -    ;   count.
+    @param  count    -  ,  1  64.
+    @retval          -  .
+**/
+quint64 readBits(const uchar* data, int& position, int count) {
+	quint64 value = 0;
+	while (count > 0) {
+		int available = 8 - (position & 7);
+		int n = qMin(available, count);
+		quint64 bits = (data[position >> 3] >> (available - n)) & ((1u << n) - 1);
+		value = (value << n) | bits;
+		position += n;
+		count -= n;
+	}
+	return value;
+}
+
+/**
+    @brief  ,       .
+	     .
+    @param  seconds -   .
+    @retval         -   .
+**/
+inline qint64 toMilliseconds(double seconds) {
+	return qRound64(qBound(-9.0e18, seconds * 1000.0, 9.0e18));
+}
+
+/**
+    @brief  ,    .
+    @param  value - .
+    @retval       -  .
+**/
+inline quint64 toBits(double value) {
+	quint64 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+/**
+    @brief  ,      .
+    @param  bits -  .
+    @retval      - .
+**/
+inline double fromBits(quint64 bits) {
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+}
+
+/**
+    @brief   .      open().
+    @param path -      .
+**/
+TelemetryStore::TelemetryStore(const QString& path)
+	: path(path), dataFile(path + ".dat"), indexFile(path + ".idx"), dataSize(0), pointCount(0), decodedBlockCount(0) {
+}
+
+/**
+    @brief   .     .
+**/
+TelemetryStore::~TelemetryStore() {
+	close();
+}
+
+/**
+    @brief  ,       
+	 .    ,    
+	(,   ),     
+	.
+    @retval  -  true,   ,  false.
+**/
+bool TelemetryStore::open() {
+	close();
+	if (!dataFile.open(QFile::ReadWrite) || !indexFile.open(QFile::ReadWrite)) {
+		close();
+		return false;
+	}
+	qint64 storedSize = dataFile.size();
+	blockIndex.resize(int(indexFile.size() / qint64(sizeof(BlockIndexEntry))));
+	indexFile.seek(0);
+	indexFile.read(reinterpret_cast<char*>(blockIndex.data()), blockIndex.size() * qint64(sizeof(BlockIndexEntry)));
+	int entryCount = 0;
+	while (entryCount < blockIndex.size()) {
+		const BlockIndexEntry& entry = blockIndex[entryCount];
+		if (entry.offset != dataSize || entry.size <= 0 || entry.size > TELEMETRY_BLOCK_SIZE || entry.offset + entry.size > storedSize) {
+			break;
+		}
+		dataSize += entry.size;
+		entryCount++;
+	}
+	blockIndex.resize(entryCount);
+	indexFile.resize(entryCount * qint64(sizeof(BlockIndexEntry)));
+	dataFile.resize(dataSize);
+	for (int i = 0; i < blockIndex.size(); i++) {
+		unitBlocks[blockIndex[i].unit].append(i);
+		pointCount += blockIndex[i].pointCount;
+	}
+	return true;
+}
+
+/**
+    @brief ,       
+	.        
+	.
+**/
+void TelemetryStore::close() {
+	if (isOpen()) {
+		for (QHash<int, ActiveBlock*>::const_iterator it = activeBlocks.constBegin(); it != activeBlocks.constEnd(); ++it) {
+			sealBlock(it.key(), it.value());
+		}
+	}
+	qDeleteAll(activeBlocks);
+	activeBlocks.clear();
+	blockIndex.clear();
+	unitBlocks.clear();
+	dataSize = 0;
+	pointCount = 0;
+	dataFile.close();
+	indexFile.close();
+}
+
+/**
+    @brief  , ,   .
+    @retval  -  true,   ,  false.
+**/
+bool TelemetryStore::isOpen() const {
+	return dataFile.isOpen() && indexFile.isOpen();
+}
+
+/**
+    @brief  ,     .
+	        .
+	        ,  
+	    .
+    @param  unit   -   .
+    @param  sample -  ;   .
+    @retval        -  true,   ,  false.
+**/
+bool TelemetryStore::append(int unit, const SensorSample& sample) {
+	if (!isOpen()) {
+		return false;
+	}
+	qint64 time = toMilliseconds(sample.timestamp);
+	ActiveBlock* block = activeBlocks.value(unit, nullptr);
+	qint64 lastTime = block != nullptr ? block->lastTime : (unitBlocks.contains(unit) ? blockIndex[unitBlocks[unit].last()].lastTime : LLONG_MIN);
+	if (time <= lastTime) {
+		return false;
+	}
+	if (block != nullptr && block->bitPosition + MAX_POINT_BITS > TELEMETRY_BLOCK_SIZE * 8) {
+		sealBlock(unit, block);
+		delete block;
+		activeBlocks.remove(unit);
+		block = nullptr;
+	}
+	const quint64 values[CHANNEL_COUNT] = { toBits(sample.temperature), toBits(sample.humidity), toBits(sample.pressure) };
+	if (block == nullptr) {
+		block = new ActiveBlock();
+		block->data.fill(0, TELEMETRY_BLOCK_SIZE);
+		block->bitPosition = 0;
+		block->pointCount = 0;
+		block->firstTime = time;
+		block->lastDelta = 0;
+		activeBlocks.insert(unit, block);
+		uchar* data = reinterpret_cast<uchar*>(block->data.data());
+		writeBits(data, block->bitPosition, quint64(time), 64);
+		for (int c = 0; c < CHANNEL_COUNT; c++) {
+			writeBits(data, block->bitPosition, values[c], 64);
+			block->lastValues[c] = values[c];
+			block->leading[c] = -1;
+			block->trailing[c] = 0;
+		}
+	}
+	else {
+		uchar* data = reinterpret_cast<uchar*>(block->data.data());
+		qint64 delta = time - block->lastTime;
+		qint64 deltaOfDelta = delta - block->lastDelta;
+		if (deltaOfDelta == 0) {
+			writeBits(data, block->bitPosition, 0, 1);
+		}
+		else if (deltaOfDelta >= -63 && deltaOfDelta <= 64) {
+			writeBits(data, block->bitPosition, 0x2, 2);
+			writeBits(data, block->bitPosition, quint64(deltaOfDelta + 63), 7);
+		}
+		else if (deltaOfDelta >= -255 && deltaOfDelta <= 256) {
+			writeBits(data, block->bitPosition, 0x6, 3);
+			writeBits(data, block->bitPosition, quint64(deltaOfDelta + 255), 9);
+		}
+		else if (deltaOfDelta >= -2047 && deltaOfDelta <= 2048) {
+			writeBits(data, block->bitPosition, 0xE, 4);
+			writeBits(data, block->bitPosition, quint64(deltaOfDelta + 2047), 12);
+		}
+		else {
+			writeBits(data, block->bitPosition, 0xF, 4);
+			writeBits(data, block->bitPosition, quint64(deltaOfDelta), 64);
+		}
+		block->lastDelta = delta;
+		for (int c = 0; c < CHANNEL_COUNT; c++) {
+			quint64 xored = values[c] ^ block->lastValues[c];
+			block->lastValues[c] = values[c];
+			if (xored == 0) {
+				writeBits(data, block->bitPosition, 0, 1);
+				continue;
+			}
+			int leading = qMin(int(qCountLeadingZeroBits(xored)), 31);
+			int trailing = int(qCountTrailingZeroBits(xored));
+			if (block->leading[c] >= 0 && leading >= block->leading[c] && trailing >= block->trailing[c]) {
+				writeBits(data, block->bitPosition, 0x2, 2);
+				writeBits(data, block->bitPosition, xored >> block->trailing[c], 64 - block->leading[c] - block->trailing[c]);
+			}
+			else {
+				int significant = 64 - leading - trailing;
+				writeBits(data, block->bitPosition, 0x3, 2);
+				writeBits(data, block->bitPosition, quint64(leading), 5);
+				writeBits(data, block->bitPosition, quint64(significant - 1), 6);
+				writeBits(data, block->bitPosition, xored >> trailing, significant);
+				block->leading[c] = leading;
+				block->trailing[c] = trailing;
+			}
+		}
+	}
+	block->lastTime = time;
+	block->pointCount++;
+	pointCount++;
+	return true;
+}
+
+/**
+    @brief  ,      
+	 .    ,  
+	;      .
+    @param  unit    -   .
+    @param  from    -     .
+    @param  to      -     .
+    @param  samples - ,        .
+    @retval         -   .
+**/
+int TelemetryStore::query(int unit, double from, double to, QVector<SensorSample>& samples) {
+	if (!isOpen()) {
+		return 0;
+	}
+	int added = 0;
+	qint64 fromTime = toMilliseconds(from);
+	qint64 toTime = toMilliseconds(to);
+	QByteArray buffer(TELEMETRY_BLOCK_SIZE, 0);
+	const QVector<int> blocks = unitBlocks.value(unit);
+	QVector<int>::const_iterator it = std::lower_bound(blocks.constBegin(), blocks.constEnd(), fromTime,
+		[this](int block, qint64 time) { return blockIndex[block].lastTime < time; });
+	for (; it != blocks.constEnd() && blockIndex[*it].firstTime <= toTime; ++it) {
+		const BlockIndexEntry& entry = blockIndex[*it];
+		dataFile.seek(entry.offset);
+		if (dataFile.read(buffer.data(), entry.size) != entry.size) {
+			break;
+		}
+		std::memset(buffer.data() + entry.size, 0, size_t(TELEMETRY_BLOCK_SIZE - entry.size));
+		added += decodeBlock(buffer.constData(), entry.pointCount, from, to, samples);
+	}
+	ActiveBlock* block = activeBlocks.value(unit, nullptr);
+	if (block != nullptr && block->firstTime <= toTime && block->lastTime >= fromTime) {
+		added += decodeBlock(block->data.constData(), block->pointCount, from, to, samples);
+	}
+	return added;
+}
+
+/**
+    @brief  ,      .
+    @retval  -  .
+**/
+qint64 TelemetryStore::getPointCount() const {
+	return pointCount;
+}
+
+/**
+    @brief  ,   :   ,
+	     .
+    @retval  -   .
+**/
+qint64 TelemetryStore::getStoredBytes() const {
+	qint64 bytes = dataSize + qint64(blockIndex.size()) * qint64(sizeof(BlockIndexEntry));
+	for (const ActiveBlock* block : activeBlocks) {
+		bytes += (block->bitPosition + 7) / 8 + qint64(sizeof(BlockIndexEntry));
+	}
+	return bytes;
+}
+
+/**
+    @brief  ,     .
+    @retval  -  .
+**/
+int TelemetryStore::getBlockCount() const {
+	return blockIndex.size();
+}
+
+/**
+    @brief  ,    , 
+	    .
+    @retval  -  .
+**/
+qint64 TelemetryStore::getDecodedBlockCount() const {
+	return decodedBlockCount;
+}
+
+/**
+    @brief ,         
+	  .
+    @param unit  -   .
+    @param block -   .
+**/
+void TelemetryStore::sealBlock(int unit, ActiveBlock* block) {
+	BlockIndexEntry entry;
+	entry.unit = unit;
+	entry.pointCount = block->pointCount;
+	entry.firstTime = block->firstTime;
+	entry.lastTime = block->lastTime;
+	entry.offset = dataSize;
+	entry.size = (block->bitPosition + 7) / 8;
+	dataFile.seek(entry.offset);
+	dataFile.write(block->data.constData(), entry.size);
+	indexFile.seek(qint64(blockIndex.size()) * qint64(sizeof(BlockIndexEntry)));
+	indexFile.write(reinterpret_cast<const char*>(&entry), sizeof(BlockIndexEntry));
+	dataFile.flush();
+	indexFile.flush();
+	unitBlocks[unit].append(blockIndex.size());
+	blockIndex.append(entry);
+	dataSize += entry.size;
+}
+
+/**
+    @brief  ,      , 
+	 .     .
+    @param  data       -  .
+    @param  pointCount -    .
+    @param  from       -    .
+    @param  to         -    .
+    @param  samples    - ,     .
+    @retval            -   .
+**/
+int TelemetryStore::decodeBlock(const char* data, int pointCount, double from, double to, QVector<SensorSample>& samples) {
+	decodedBlockCount++;
+	const uchar* bits = reinterpret_cast<const uchar*>(data);
+	const qint64 fromTime = toMilliseconds(from);
+	const qint64 toTime = toMilliseconds(to);
+	int position = 0;
+	int added = 0;
+	qint64 time = qint64(readBits(bits, position, 64));
+	qint64 delta = 0;
+	quint64 values[CHANNEL_COUNT];
+	int leading[CHANNEL_COUNT];
+	int trailing[CHANNEL_COUNT];
+	for (int c = 0; c < CHANNEL_COUNT; c++) {
+		values[c] = readBits(bits, position, 64);
+		leading[c] = 0;
+		trailing[c] = 0;
+	}
+	for (int i = 0; i < pointCount; i++) {
+		if (i > 0) {
+			qint64 deltaOfDelta = 0;
+			if (readBits(bits, position, 1) != 0) {
+				if (readBits(bits, position, 1) == 0) {
+					deltaOfDelta = qint64(readBits(bits, position, 7)) - 63;
+				}
+				else if (readBits(bits, position, 1) == 0) {
+					deltaOfDelta = qint64(readBits(bits, position, 9)) - 255;
+				}
+				else if (readBits(bits, position, 1) == 0) {
+					deltaOfDelta = qint64(readBits(bits, position, 12)) - 2047;
+				}
+				else {
+					deltaOfDelta = qint64(readBits(bits, position, 64));
+				}
+			}
+			delta += deltaOfDelta;
+			time += delta;
+			for (int c = 0; c < CHANNEL_COUNT; c++) {
+				if (readBits(bits, position, 1) == 0) {
+					continue;
+				}
+				if (readBits(bits, position, 1) != 0) {
+					leading[c] = int(readBits(bits, position, 5));
+					int significant = int(readBits(bits, position, 6)) + 1;
+					trailing[c] = 64 - leading[c] - significant;
+				}
+				values[c] ^= readBits(bits, position, 64 - leading[c] - trailing[c]) << trailing[c];
+			}
+		}
+		if (time > toTime) {
+			break;
+		}
+		if (time >= fromTime) {
+			samples.append({ time / 1000.0, fromBits(values[0]), fromBits(values[1]), fromBits(values[2]) });
+			added++;
+		}
+	}
+	return added;
+}
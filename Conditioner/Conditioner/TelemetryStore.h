@@ -0,0 +1,86 @@
+#pragma once
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "SensorLogReader.h"
+
+/**
+
+	@class   TelemetryStore
+	@brief        
+	     Gorilla.     (, ,
+	, )     : 
+	   ,  -  XOR 
+	    .    
+	,          
+	   ,    
+	     .    
+	  path.dat  path.idx,      .
+	       ,   
+	  ,   ,  
+	 ,    .
+
+**/
+class TelemetryStore {
+public:
+	TelemetryStore(const QString& path);
+	~TelemetryStore();
+
+	bool open();
+	void close();
+	bool isOpen() const;
+
+	bool append(int unit, const SensorSample& sample);
+	int query(int unit, double from, double to, QVector<SensorSample>& samples);
+
+	qint64 getPointCount() const;
+	qint64 getStoredBytes() const;
+	int getBlockCount() const;
+	qint64 getDecodedBlockCount() const;
+
+private:
+	/**
+		@struct  BlockIndexEntry
+		@brief        .
+	**/
+	struct BlockIndexEntry {
+		qint32 unit;
+		qint32 pointCount;
+		qint64 firstTime;
+		qint64 lastTime;
+		qint64 offset;
+		qint64 size;
+	};
+
+	/**
+		@struct  ActiveBlock
+		@brief         .
+	**/
+	struct ActiveBlock {
+		QByteArray data;
+		int bitPosition;
+		int pointCount;
+		qint64 firstTime;
+		qint64 lastTime;
+		qint64 lastDelta;
+		quint64 lastValues[3];
+		int leading[3];
+		int trailing[3];
+	};
+
+	void sealBlock(int unit, ActiveBlock* block);
+	int decodeBlock(const char* data, int pointCount, double from, double to, QVector<SensorSample>& samples);
+
+	QString path;
+	QFile dataFile;
+	QFile indexFile;
+
+	QVector<BlockIndexEntry> blockIndex;
+	QHash<int, QVector<int>> unitBlocks;
+	QHash<int, ActiveBlock*> activeBlocks;
+
+	qint64 dataSize;
+	qint64 pointCount;
+	qint64 decodedBlockCount;
+};
@@ -0,0 +1,208 @@
+#include "UnitSimulation.h"
+#include "FaultRuleEngine.h"
+#include "AppData.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+    @brief    SplitMix64,   
+	   .
+    @param  value -  .
+    @retval       -  .
+**/
+inline quint64 mix(quint64 value) {
+	value += 0x9E3779B97F4A7C15ull;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+}
+
+/**
+    @brief  ,     FNV-1a.
+    @param  hash  -   .
+    @param  data  -  .
+    @param  size  -    .
+    @retval       -   .
+**/
+quint64 hashBytes(quint64 hash, const void* data, size_t size) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+	}
+	return hash;
+}
+
+}
+
+/**
+    @brief     . 
+	    .
+    @param unitCount -  .
+    @param seed      -    .
+**/
+UnitSimulation::UnitSimulation(int unitCount, quint64 seed)
+	: unitCount(unitCount), seed(seed), stepIndex(0), setpoint(unitCount, 22.0), ambient(unitCount),
+	temperature(unitCount), humidity(unitCount), pressure(unitCount), energy(unitCount, 0.0), faults(unitCount, 0) {
+	for (int i = 0; i < unitCount; i++) {
+		ambient[i] = 20.0 + 15.0 * random(i, 0);
+		temperature[i] = ambient[i];
+		humidity[i] = 30.0 + 40.0 * random(i, 1);
+		pressure[i] = 101325.0 + 1000.0 * (random(i, 2) - 0.5);
+	}
+}
+
+/**
+    @brief  ,   .
+    @retval  -  .
+**/
+int UnitSimulation::getUnitCount() const {
+	return unitCount;
+}
+
+/**
+    @brief  ,     .
+    @retval  -  .
+**/
+qint64 UnitSimulation::getStepIndex() const {
+	return stepIndex;
+}
+
+/**
+    @brief  ,   ,    .
+    @retval  -    SIMULATION_CHUNK_SIZE .
+**/
+int UnitSimulation::getChunkCount() const {
+	return (unitCount + SIMULATION_CHUNK_SIZE - 1) / SIMULATION_CHUNK_SIZE;
+}
+
+/**
+    @brief ,    .
+    @param unit    -  .
+    @param celsius -     .
+**/
+void UnitSimulation::setSetpoint(int unit, double celsius) {
+	setpoint[unit] = celsius;
+}
+
+/**
+    @brief  ,     .
+    @param  unit -  .
+    @retval      -    .
+**/
+double UnitSimulation::getTemperature(int unit) const {
+	return temperature[unit];
+}
+
+/**
+    @brief  ,     .
+    @param  unit -  .
+    @retval      -   .
+**/
+double UnitSimulation::getHumidity(int unit) const {
+	return humidity[unit];
+}
+
+/**
+    @brief  ,     .
+    @param  unit -  .
+    @retval      -   .
+**/
+double UnitSimulation::getPressure(int unit) const {
+	return pressure[unit];
+}
+
+/**
+    @brief  ,  ,  .
+    @param  unit -  .
+    @retval      -    *.
+**/
+double UnitSimulation::getConsumedEnergy(int unit) const {
+	return energy[unit];
+}
+
+/**
+    @brief  ,  ,    .
+    @param  unit -  .
+    @retval      -  FaultBlock.
+**/
+quint8 UnitSimulation::getFaults(int unit) const {
+	return faults[unit];
+}
+
+/**
+    @brief ,     .  
+	   .
+    @param pool    -  .
+    @param seconds -    .
+**/
+void UnitSimulation::step(WorkStealingPool& pool, double seconds) {
+	pool.run(getChunkCount(), [this, seconds](int chunk) {
+		int begin = chunk * SIMULATION_CHUNK_SIZE;
+		stepRange(begin, qMin(begin + SIMULATION_CHUNK_SIZE, unitCount), seconds);
+	});
+	stepIndex++;
+}
+
+/**
+    @brief  ,      ,
+	    .
+    @retval  -  FNV-1a .
+**/
+quint64 UnitSimulation::computeChecksum() const {
+	quint64 hash = 0xCBF29CE484222325ull;
+	hash = hashBytes(hash, temperature.constData(), sizeof(double) * size_t(unitCount));
+	hash = hashBytes(hash, humidity.constData(), sizeof(double) * size_t(unitCount));
+	hash = hashBytes(hash, pressure.constData(), sizeof(double) * size_t(unitCount));
+	hash = hashBytes(hash, energy.constData(), sizeof(double) * size_t(unitCount));
+	hash = hashBytes(hash, faults.constData(), size_t(unitCount));
+	return hash;
+}
+
+/**
+    @brief ,      .
+	        
+	 ,   ,  
+	   .   
+	  .
+    @param begin   -    .
+    @param end     -  ,   .
+    @param seconds -    .
+**/
+void UnitSimulation::stepRange(int begin, int end, double seconds) {
+	const double hours = seconds / 3600.0;
+	for (int i = begin; i < end; i++) {
+		double working = (faults[i] & OuterBlockFault) ? 0.0 : 1.0;
+		double delta = setpoint[i] - temperature[i];
+		double effort = std::min(1.0, std::max(-1.0, delta / FULL_LOAD_DELTA)) * working;
+		double load = std::min(1.0, std::max(MIN_COMPRESSOR_LOAD, std::fabs(delta) / FULL_LOAD_DELTA)) * working;
+		temperature[i] += seconds * ((ambient[i] - temperature[i]) / SIMULATION_THERMAL_TIME_CONSTANT + effort * SIMULATION_CONDITIONING_RATE)
+			+ (random(i, 3) - 0.5) * SIMULATION_SENSOR_NOISE;
+		humidity[i] = std::min(100.0, std::max(0.0, humidity[i] - seconds * load * SIMULATION_DRYING_RATE
+			+ (random(i, 4) - 0.5) * SIMULATION_SENSOR_NOISE));
+		pressure[i] += (101325.0 - pressure[i]) * 0.01 + (random(i, 5) - 0.5) * SIMULATION_PRESSURE_NOISE;
+		energy[i] += (FAN_POWER + COMPRESSOR_RATED_POWER * load) * hours;
+		if (faults[i] == 0) {
+			double chance = random(i, 6);
+			if (chance < SIMULATION_FAULT_RATE * seconds) {
+				faults[i] = chance < SIMULATION_FAULT_RATE * seconds / 2.0 ? InnerBlockFault : OuterBlockFault;
+			}
+		}
+		else if (random(i, 7) < SIMULATION_REPAIR_RATE * seconds) {
+			faults[i] = 0;
+		}
+	}
+}
+
+/**
+    @brief  ,   ,    ,
+	 ,       .
+    @param  unit   -  .
+    @param  stream -      .
+    @retval        -     [0; 1).
+**/
+double UnitSimulation::random(int unit, int stream) const {
+	quint64 value = mix(seed ^ mix(quint64(unit) * 8 + quint64(stream)) ^ mix(quint64(stepIndex) + 0x632BE59BD9B4E019ull));
+	return double(value >> 11) * (1.0 / 9007199254740992.0);
+}
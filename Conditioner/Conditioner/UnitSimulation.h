@@ -0,0 +1,49 @@
+#pragma once
+#include <QVector>
+#include "WorkStealingPool.h"
+
+/**
+
+	@class   UnitSimulation
+	@brief   ,      ,  
+	 :    ,   
+	         
+	.    ,   
+	 .        
+	   ,       .
+
+**/
+class UnitSimulation {
+public:
+	UnitSimulation(int unitCount, quint64 seed);
+
+	int getUnitCount() const;
+	qint64 getStepIndex() const;
+	int getChunkCount() const;
+
+	void setSetpoint(int unit, double celsius);
+	double getTemperature(int unit) const;
+	double getHumidity(int unit) const;
+	double getPressure(int unit) const;
+	double getConsumedEnergy(int unit) const;
+	quint8 getFaults(int unit) const;
+
+	void step(WorkStealingPool& pool, double seconds);
+	quint64 computeChecksum() const;
+
+private:
+	void stepRange(int begin, int end, double seconds);
+	double random(int unit, int stream) const;
+
+	int unitCount;
+	quint64 seed;
+	qint64 stepIndex;
+
+	QVector<double> setpoint;
+	QVector<double> ambient;
+	QVector<double> temperature;
+	QVector<double> humidity;
+	QVector<double> pressure;
+	QVector<double> energy;
+	QVector<quint8> faults;
+};
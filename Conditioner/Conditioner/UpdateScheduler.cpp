@@ -0,0 +1,230 @@
+#include "UpdateScheduler.h"
+#include "AppData.h"
+#include <QtMath>
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_UNIX)
+#include <time.h>
+#endif
+
+/**
+    @brief   .
+    @param band -   .
+**/
+ChangeDetector::ChangeDetector(double band) : band(band), reference(0.0), primed(false) {
+}
+
+/**
+    @brief  , ,       
+	 .     .
+    @param  value -  .
+    @retval       -  true,   ,  false.
+**/
+bool ChangeDetector::update(double value) {
+	if (primed && qAbs(value - reference) <= band) {
+		return false;
+	}
+	reference = value;
+	primed = true;
+	return true;
+}
+
+/**
+    @brief  .   .
+    @param parent -   ,    nullptr.
+**/
+UpdateScheduler::UpdateScheduler(QObject* parent) : active(false), wakeups(0), periodWakeups(0), periodStart(0), periodCpuTime(0) {
+	timer = new QTimer(parent);
+	timer->setSingleShot(true);
+	timer->setTimerType(Qt::CoarseTimer);
+	QObject::connect(timer, &QTimer::timeout, timer, [this] { runDueTasks(); });
+	clock.start();
+}
+
+/**
+    @brief  .
+**/
+UpdateScheduler::~UpdateScheduler() {
+	delete timer;
+}
+
+/**
+    @brief  ,   .
+    @param  interval    -     .
+    @param  maxInterval -       .
+    @param  task        -  ;  true,   
+	   .
+    @retval             -  .
+**/
+int UpdateScheduler::addTask(int interval, int maxInterval, const std::function<bool()>& task) {
+	tasks.append({ task, interval, qMax(interval, maxInterval), interval, 0, clock.elapsed() + interval });
+	if (active) {
+		schedule();
+	}
+	return tasks.size() - 1;
+}
+
+/**
+    @brief ,  .    
+	,     .
+**/
+void UpdateScheduler::start() {
+	if (active) {
+		return;
+	}
+	active = true;
+	periodStart = clock.elapsed();
+	periodCpuTime = getProcessCpuTime();
+	periodWakeups = 0;
+	for (Task& task : tasks) {
+		task.currentInterval = task.interval;
+		task.stableTicks = 0;
+		task.due = periodStart + task.interval;
+	}
+	schedule();
+}
+
+/**
+    @brief ,  :   ,
+	    .
+**/
+void UpdateScheduler::stop() {
+	if (!active) {
+		return;
+	}
+	timer->stop();
+	active = false;
+	periodStart = clock.elapsed();
+	periodCpuTime = getProcessCpuTime();
+	periodWakeups = 0;
+}
+
+/**
+    @brief  , ,   .
+    @retval  -  true,   ,  false.
+**/
+bool UpdateScheduler::isActive() const {
+	return active;
+}
+
+/**
+    @brief ,       
+	,   .   
+	,        , 
+	    .
+**/
+void UpdateScheduler::wake() {
+	if (!active) {
+		return;
+	}
+	qint64 now = clock.elapsed();
+	bool changed = false;
+	for (Task& task : tasks) {
+		task.stableTicks = 0;
+		if (task.currentInterval != task.interval) {
+			task.currentInterval = task.interval;
+			task.due = qMin(task.due, now + task.interval);
+			changed = true;
+		}
+	}
+	if (changed) {
+		schedule();
+	}
+}
+
+/**
+    @brief  ,    .
+    @param  task -  .
+    @retval      -   .
+**/
+int UpdateScheduler::getInterval(int task) const {
+	return tasks[task].currentInterval;
+}
+
+/**
+    @brief  ,      
+	 .
+    @retval  -  .
+**/
+qint64 UpdateScheduler::getWakeupCount() const {
+	return wakeups;
+}
+
+/**
+    @brief  ,      
+	: ,     
+	    .
+    @retval  -  .
+**/
+QString UpdateScheduler::formatStatistics() const {
+	double seconds = qMax(clock.elapsed() - periodStart, qint64(1)) / 1000.0;
+	double cpu = (getProcessCpuTime() - periodCpuTime) / 1e6;
+	return QString("%1 s, %2 wakeups/s, CPU %3 ms/s").arg(seconds, 0, 'f', 1).arg(periodWakeups / seconds, 0, 'f', 2).arg(cpu / seconds, 0, 'f', 3);
+}
+
+/**
+    @brief  ,   ,  .
+    @retval  -     0,    .
+**/
+qint64 UpdateScheduler::getProcessCpuTime() {
+#if defined(Q_OS_WIN)
+	FILETIME creation, exit, kernel, user;
+	if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+		return 0;
+	}
+	quint64 kernelTime = (quint64(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+	quint64 userTime = (quint64(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+	return qint64(kernelTime + userTime) * 100;
+#elif defined(Q_OS_UNIX)
+	timespec time;
+	if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) {
+		return 0;
+	}
+	return qint64(time.tv_sec) * 1000000000 + time.tv_nsec;
+#else
+	return 0;
+#endif
+}
+
+/**
+    @brief ,  ,      
+	  ,    .
+**/
+void UpdateScheduler::runDueTasks() {
+	if (!active) {
+		return;
+	}
+	wakeups++;
+	periodWakeups++;
+	qint64 now = clock.elapsed();
+	for (int i = 0; i < tasks.size(); i++) {
+		if (tasks[i].due > now + SCHEDULER_COALESCING_WINDOW) {
+			continue;
+		}
+		bool changed = tasks[i].callback();
+		Task& task = tasks[i];
+		if (changed) {
+			task.stableTicks = 0;
+			task.currentInterval = task.interval;
+		}
+		else if (++task.stableTicks >= SCHEDULER_STABLE_TICKS) {
+			task.currentInterval = qMin(task.currentInterval * 2, task.maxInterval);
+		}
+		task.due = now + task.currentInterval;
+	}
+	schedule();
+}
+
+/**
+    @brief ,      .
+**/
+void UpdateScheduler::schedule() {
+	if (!active || tasks.isEmpty()) {
+		return;
+	}
+	qint64 next = tasks[0].due;
+	for (const Task& task : tasks) {
+		next = qMin(next, task.due);
+	}
+	timer->start(int(qMax(next - clock.elapsed(), qint64(0))));
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+
+/**
+
+	@class   ChangeDetector
+	@brief   ,     
+	:  ,     
+	    ,  
+	      .
+
+**/
+class ChangeDetector {
+public:
+	ChangeDetector(double band);
+
+	bool update(double value);
+
+private:
+	double band;
+	double reference;
+	bool primed;
+};
+
+/**
+
+	@class   UpdateScheduler
+	@brief      .  
+	  : ,     
+	 ,    .  , 
+	 ;  SCHEDULER_STABLE_TICKS    
+	   ,    
+	  .    
+	.      ;
+	   idle.
+
+**/
+class UpdateScheduler {
+public:
+	UpdateScheduler(QObject* parent = nullptr);
+	~UpdateScheduler();
+
+	int addTask(int interval, int maxInterval, const std::function<bool()>& task);
+	void start();
+	void stop();
+	bool isActive() const;
+	void wake();
+
+	int getInterval(int task) const;
+	qint64 getWakeupCount() const;
+	QString formatStatistics() const;
+
+	static qint64 getProcessCpuTime();
+
+private:
+	struct Task {
+		std::function<bool()> callback;
+		int interval;
+		int maxInterval;
+		int currentInterval;
+		int stableTicks;
+		qint64 due;
+	};
+
+	void runDueTasks();
+	void schedule();
+
+	QTimer* timer;
+	QVector<Task> tasks;
+	QElapsedTimer clock;
+	bool active;
+
+	qint64 wakeups;
+	qint64 periodWakeups;
+	qint64 periodStart;
+	qint64 periodCpuTime;
+};
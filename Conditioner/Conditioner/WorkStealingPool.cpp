@@ -0,0 +1,152 @@
+#include "WorkStealingPool.h"
+
+/**
+    @brief   .
+    @param threadCount -   ,  .
+	  1   1.
+**/
+WorkStealingPool::WorkStealingPool(int threadCount)
+	: threadCount(qMax(threadCount, 1)), currentTask(nullptr), generation(0), stopping(false), remaining(0), steals(0) {
+	for (int i = 0; i < this->threadCount; i++) {
+		queues.emplace_back(new WorkerQueue());
+	}
+	for (int i = 1; i < this->threadCount; i++) {
+		threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+	}
+}
+
+/**
+    @brief   .    .
+**/
+WorkStealingPool::~WorkStealingPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+/**
+    @brief  ,    .
+    @retval  -  ,  .
+**/
+int WorkStealingPool::getThreadCount() const {
+	return threadCount;
+}
+
+/**
+    @brief  ,       
+	 .
+    @retval  -  .
+**/
+qint64 WorkStealingPool::getStealCount() const {
+	return steals.load();
+}
+
+/**
+    @brief ,      0  taskCount - 1 
+	     .
+    @param taskCount -  .
+    @param task      - ,     . 
+	   .
+**/
+void WorkStealingPool::run(int taskCount, const std::function<void(int)>& task) {
+	if (taskCount <= 0) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		currentTask = &task;
+		remaining.store(taskCount);
+		generation++;
+	}
+	for (int worker = 0; worker < threadCount; worker++) {
+		int begin = int(qint64(taskCount) * worker / threadCount);
+		int end = int(qint64(taskCount) * (worker + 1) / threadCount);
+		std::lock_guard<std::mutex> lock(queues[worker]->mutex);
+		for (int i = begin; i < end; i++) {
+			queues[worker]->tasks.push_back(i);
+		}
+	}
+	wake.notify_all();
+	runTasks(0);
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this] { return remaining.load() == 0; });
+}
+
+/**
+    @brief ,    :  
+	 run()   .
+    @param worker -   .
+**/
+void WorkStealingPool::workerLoop(int worker) {
+	quint64 seenGeneration = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+			if (stopping) {
+				return;
+			}
+			seenGeneration = generation;
+		}
+		runTasks(worker);
+	}
+}
+
+/**
+    @brief ,      ,  
+	  -    .
+    @param worker -  .
+**/
+void WorkStealingPool::runTasks(int worker) {
+	int task;
+	while (popTask(worker, task) || stealTask(worker, task)) {
+		(*currentTask)(task);
+		if (remaining.fetch_sub(1) == 1) {
+			std::lock_guard<std::mutex> lock(mutex);
+			done.notify_all();
+		}
+	}
+}
+
+/**
+    @brief  ,       .
+    @param  worker -  .
+    @param  task   - ,     .
+    @retval        -  true,   ,  false.
+**/
+bool WorkStealingPool::popTask(int worker, int& task) {
+	WorkerQueue& queue = *queues[worker];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.tasks.empty()) {
+		return false;
+	}
+	task = queue.tasks.back();
+	queue.tasks.pop_back();
+	return true;
+}
+
+/**
+    @brief  ,       .
+	   ,    .
+    @param  worker -  ,  .
+    @param  task   - ,     .
+    @retval        -  true,   ,  false.
+**/
+bool WorkStealingPool::stealTask(int worker, int& task) {
+	for (int offset = 1; offset < threadCount; offset++) {
+		WorkerQueue& queue = *queues[(worker + offset) % threadCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()) {
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+			steals++;
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+
+	@class   WorkStealingPool
+	@brief       .    
+	  ;       ,
+	 ,      . 
+	      .
+
+**/
+class WorkStealingPool {
+public:
+	WorkStealingPool(int threadCount);
+	~WorkStealingPool();
+
+	int getThreadCount() const;
+	qint64 getStealCount() const;
+
+	void run(int taskCount, const std::function<void(int)>& task);
+
+private:
+	struct WorkerQueue {
+		std::mutex mutex;
+		std::deque<int> tasks;
+	};
+
+	void workerLoop(int worker);
+	void runTasks(int worker);
+	bool popTask(int worker, int& task);
+	bool stealTask(int worker, int& task);
+
+	int threadCount;
+	std::vector<std::thread> threads;
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	const std::function<void(int)>* currentTask;
+	quint64 generation;
+	bool stopping;
+	std::atomic<int> remaining;
+	std::atomic<qint64> steals;
+};
@@ -1,12 +1,33 @@
 #include "CustomMainWindow.h"
 #include "AppData.h"
+#include "Benchmark.h"
+#include "StartupTrace.h"
 #include <QtWidgets/QApplication>
 #include <QFile>
+#include <QPixmapCache>
 
 int main(int argc, char* argv[]) {
+	StartupTrace::start();
+	if (argc > 2 && QString(argv[1]) == "--benchmark") {
+		QString name(argv[2]);
+		bool widgets = name == "fuzz" || name == "setpoint" || name == "memory";
+		if (widgets && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+			qputenv("QT_QPA_PLATFORM", "offscreen");
+		}
+		QCoreApplication* benchmarkApp = widgets ? new QApplication(argc, argv) : new QCoreApplication(argc, argv);
+		QStringList arguments = benchmarkApp->arguments();
+		int result = runBenchmark(arguments.at(2), arguments.mid(3));
+		delete benchmarkApp;
+		return result;
+	}
 	QApplication a(argc, argv);
+	bool lowMemoryMode = a.arguments().contains("--low-memory");
+	bool viewerMode = a.arguments().contains("--viewer");
+	if (lowMemoryMode) {
+		QPixmapCache::setCacheLimit(LOW_MEMORY_PIXMAP_CACHE_LIMIT);
+	}
 	a.setWindowIcon(QIcon(appIcon));
-	CustomMainWindow w;
+	CustomMainWindow w(nullptr, lowMemoryMode, viewerMode);
 	w.show();
 	return a.exec();
 }